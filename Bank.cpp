@@ -7,11 +7,15 @@
 
 
 #include "Bank.h"
+#include "EvalContext.h"
 
 Bank::Bank() {
 	// TODO Auto-generated constructor stub
 	initialized = false;
 	invalid = false;
+	routable = false;
+	rerouting = false;
+	context = NULL;
 }
 
 Bank::~Bank() {
@@ -43,6 +47,7 @@ Bank & Bank::operator=(const Bank &rhs) {
 	leakage = rhs.leakage;
 	initialized = rhs.initialized;
 	invalid = rhs.invalid;
+	routable = rhs.routable;
 	numRowMat = rhs.numRowMat;
 	numColumnMat = rhs.numColumnMat;
 	capacity = rhs.capacity;
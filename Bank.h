@@ -27,15 +27,18 @@ public:
 			int _numRowSubarray, int _numColumnSubarray,
 			int _numActiveSubarrayPerRow, int _numActiveSubarrayPerColumn,
 			BufferDesignTarget _areaOptimizationLevel, MemoryType _memoryType,
-            int _stackedDieCount, int _paritionGranularity, int monolithicStackCount) = 0;
+            int _stackedDieCount, int _paritionGranularity, int monolithicStackCount, EvalContext *_context = NULL) = 0;
 	virtual void CalculateArea() = 0;
 	virtual void CalculateRC() = 0;
 	virtual void CalculateLatencyAndPower() = 0;
+	virtual void Reroute() = 0;		/* Recalculate the routing with the current global wire, the mat is reused */
 	virtual Bank & operator=(const Bank &);
 
 	/* Properties */
 	bool initialized;	/* Initialization flag */
 	bool invalid;		/* Indicate that the current configuration is not valid, pass down to all the sub-components */
+	bool routable;		/* Indicate that the initialization is valid, so that only the routing can make the bank invalid */
+	bool rerouting;		/* Set during Reroute(), the calculated mat is reused instead of calculated again */
 	bool internalSenseAmp;
 	int numRowMat;		/* Number of mat rows in a bank */
 	int numColumnMat;	/* Number of mat columns in a bank */
@@ -70,6 +73,8 @@ public:
 
 	Mat mat;
     TSV tsvArray;
+
+	EvalContext *context;	/* The evaluation state, NULL if the state bound to the calling thread is used */
 };
 
 #endif /* BANK_H_ */
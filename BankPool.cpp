@@ -0,0 +1,49 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "BankPool.h"
+#include "BankWithHtree.h"
+#include "BankWithoutHtree.h"
+#include "global.h"
+#include <new>
+
+/* Large enough for both kinds of bank */
+static const size_t bankSize = sizeof(BankWithHtree) > sizeof(BankWithoutHtree) ? sizeof(BankWithHtree) : sizeof(BankWithoutHtree);
+
+BankPool::BankPool() {
+	numAllocated = 0;
+}
+
+BankPool::~BankPool() {
+	for (int i = 0; i < (int)freeBanks.size(); i++)
+		::operator delete(freeBanks[i]);
+}
+
+BankPool & BankPool::ThreadPool() {
+	static thread_local BankPool pool;
+	return pool;
+}
+
+Bank * BankPool::Acquire() {
+	void *memory;
+	if (freeBanks.empty()) {
+		memory = ::operator new(bankSize);
+		numAllocated++;
+	} else {
+		memory = freeBanks.back();
+		freeBanks.pop_back();
+	}
+	if (inputParameter->routingMode == h_tree)
+		return new (memory) BankWithHtree();
+	else
+		return new (memory) BankWithoutHtree();
+}
+
+void BankPool::Release(Bank *bank) {
+	void *memory = dynamic_cast<void *>(bank);	/* Start of the derived object */
+	bank->~Bank();
+	freeBanks.push_back(memory);
+}
@@ -0,0 +1,36 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef BANKPOOL_H_
+#define BANKPOOL_H_
+
+#include <vector>
+#include "Bank.h"
+
+using namespace std;
+
+/* Reuses the memory of the banks that the exploration creates for every design. A released bank is
+ * destroyed and its memory is kept, the next acquired bank is constructed in place in that memory with
+ * the current routing mode, so that it starts from exactly the same state as a bank from new.
+ * Every thread has its own pool, so that no locking is needed */
+class BankPool {
+public:
+	BankPool();
+	virtual ~BankPool();
+
+	/* Functions */
+	static BankPool & ThreadPool();	/* The pool of the calling thread */
+	Bank * Acquire();				/* A new BankWithHtree or BankWithoutHtree, depending on the routing mode */
+	void Release(Bank *bank);		/* The bank must come from Acquire() of the same pool */
+
+	/* Properties */
+	long long numAllocated;			/* Number of banks that the pool had to allocate memory for */
+
+private:
+	vector<void *> freeBanks;		/* Memory of the released banks */
+};
+
+#endif /* BANKPOOL_H_ */
@@ -8,58 +8,18 @@
 #include "BankWithHtree.h"
 #include "formula.h"
 #include "global.h"
+#include "EvalContext.h"
+#include "Profiler.h"
 
 
 BankWithHtree::BankWithHtree() {
 	// TODO Auto-generated constructor stub
 	initialized = false;
 	invalid = false;
-	numHorizontalAddressBitToRoute = NULL;  /* The number of horizontal bits to route on level x */
-	numHorizontalDataDistributeBitToRoute = NULL;   /* The number of horizontal data-in bits to route on level x */
-	numHorizontalDataBroadcastBitToRoute = NULL;  /* The number of horizontal data-out bits to route on level x */
-	numHorizontalWire = NULL;		/* The number of horizontal wires on level x */
-	numSumHorizontalWire = NULL;	/* The number of total horizontal wires on level x */
-	numActiveHorizontalWire = NULL;	/* The number of active horizontal wires on level x */
-	lengthHorizontalWire = NULL;	/* The length of horizontal wires on level x, Unit: m */
-	numVerticalAddressBitToRoute = NULL;	/* The number of vertical address bits to route on level x */
-	numVerticalDataDistributeBitToRoute = NULL;  /* The number of vertical data-in bits to route on level x */
-	numVerticalDataBroadcastBitToRoute = NULL; /* The number of vertical data-out bits to route on level x */
-	numVerticalWire = NULL;			/* The number of vertical wires on level x */
-	numSumVerticalWire = NULL;		/* The number of total vertical wires on level x */
-    numActiveVerticalWire = NULL;	/* The number of active vertical wires on level x */
-	lengthVerticalWire = NULL;		/* The length of vertical wires on level 2, Unit: m */
 }
 
 BankWithHtree::~BankWithHtree() {
 	// TODO Auto-generated destructor stub
-	if (numHorizontalAddressBitToRoute)
-		delete [] numHorizontalAddressBitToRoute;
-	if (numHorizontalDataDistributeBitToRoute)
-		delete [] numHorizontalDataDistributeBitToRoute;
-	if (numHorizontalDataBroadcastBitToRoute)
-		delete [] numHorizontalDataBroadcastBitToRoute;
-	if (numHorizontalWire)
-		delete [] numHorizontalWire;
-	if (numSumHorizontalWire)
-		delete [] numSumHorizontalWire;
-	if (numActiveHorizontalWire)
-		delete [] numActiveHorizontalWire;
-	if (lengthHorizontalWire)
-		delete [] lengthHorizontalWire;
-	if (numVerticalAddressBitToRoute)
-		delete [] numVerticalAddressBitToRoute;
-	if (numVerticalDataDistributeBitToRoute)
-		delete [] numVerticalDataDistributeBitToRoute;
-	if (numVerticalDataBroadcastBitToRoute)
-		delete [] numVerticalDataBroadcastBitToRoute;
-	if (numVerticalWire)
-		delete [] numVerticalWire;
-	if (numSumVerticalWire)
-		delete [] numSumVerticalWire;
-	if (numActiveVerticalWire)
-		delete [] numActiveVerticalWire;
-	if (lengthVerticalWire)
-		delete [] lengthVerticalWire;
 }
 
 void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _capacity,
@@ -68,53 +28,15 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 		int _numRowSubarray, int _numColumnSubarray,
 		int _numActiveSubarrayPerRow, int _numActiveSubarrayPerColumn,
 		BufferDesignTarget _areaOptimizationLevel, MemoryType _memoryType,
-        int _stackedDieCount, int _partitionGranularity, int monolithicStackCount) {
+        int _stackedDieCount, int _partitionGranularity, int monolithicStackCount, EvalContext *_context) {
+	PROFILE(profile_bank_htree_initialize);
+	context = _context;
+	EvalContextScope scope(context);
+	routable = false;
 	if (initialized) {
 		/* Reset the class for re-initialization */
-		if (numHorizontalAddressBitToRoute)
-			delete [] numHorizontalAddressBitToRoute;
-		if (numHorizontalDataDistributeBitToRoute)
-			delete [] numHorizontalDataDistributeBitToRoute;
-		if (numHorizontalDataBroadcastBitToRoute)
-			delete [] numHorizontalDataBroadcastBitToRoute;
-		if (numHorizontalWire)
-			delete [] numHorizontalWire;
-		if (numSumHorizontalWire)
-			delete [] numSumHorizontalWire;
-		if (numActiveHorizontalWire)
-			delete [] numActiveHorizontalWire;
-		if (lengthHorizontalWire)
-			delete [] lengthHorizontalWire;
-		if (numVerticalAddressBitToRoute)
-			delete [] numVerticalAddressBitToRoute;
-		if (numVerticalDataDistributeBitToRoute)
-			delete [] numVerticalDataDistributeBitToRoute;
-		if (numVerticalDataBroadcastBitToRoute)
-			delete [] numVerticalDataBroadcastBitToRoute;
-		if (numVerticalWire)
-			delete [] numVerticalWire;
-		if (numSumVerticalWire)
-			delete [] numSumVerticalWire;
-		if (numActiveVerticalWire)
-			delete [] numActiveVerticalWire;
-		if (lengthVerticalWire)
-			delete [] lengthVerticalWire;
 		initialized = false;
 		invalid = false;
-		numHorizontalAddressBitToRoute = NULL;  /* The number of horizontal bits to route on level x */
-		numHorizontalDataDistributeBitToRoute = NULL;   /* The number of horizontal data-in bits to route on level x */
-		numHorizontalDataBroadcastBitToRoute = NULL;  /* The number of horizontal data-out bits to route on level x */
-		numHorizontalWire = NULL;		/* The number of horizontal wires on level x */
-		numSumHorizontalWire = NULL;	/* The number of total horizontal wires on level x */
-		numActiveHorizontalWire = NULL;	/* The number of active horizontal wires on level x */
-		lengthHorizontalWire = NULL;	/* The length of horizontal wires on level x, Unit: m */
-		numVerticalAddressBitToRoute = NULL;	/* The number of vertical address bits to route on level x */
-		numVerticalDataDistributeBitToRoute = NULL;  /* The number of vertical data-in bits to route on level x */
-		numVerticalDataBroadcastBitToRoute = NULL; /* The number of vertical data-out bits to route on level x */
-		numVerticalWire = NULL;			/* The number of vertical wires on level x */
-		numSumVerticalWire = NULL;		/* The number of total vertical wires on level x */
-	    numActiveVerticalWire = NULL;	/* The number of active vertical wires on level x */
-		lengthVerticalWire = NULL;		/* The length of vertical wires on level 2, Unit: m */
 	}
 
 	if (!_internalSenseAmp) {
@@ -193,24 +115,6 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 
 	levelHorizontal = (int)(log2(numColumnMat)+0.1);
 	levelVertical = (int)(log2(numRowMat)+0.1);
-	if (levelHorizontal > 0) {
-		numHorizontalAddressBitToRoute = new int[levelHorizontal];
-		numHorizontalDataDistributeBitToRoute = new int[levelHorizontal];
-		numHorizontalDataBroadcastBitToRoute = new int[levelHorizontal];
-		numHorizontalWire = new int[levelHorizontal];
-		numSumHorizontalWire = new int[levelHorizontal];
-		numActiveHorizontalWire = new int[levelHorizontal];
-		lengthHorizontalWire = new double[levelHorizontal];
-	}
-	if (levelVertical > 0) {
-		numVerticalAddressBitToRoute = new int[levelVertical];
-		numVerticalDataDistributeBitToRoute = new int[levelVertical];
-		numVerticalDataBroadcastBitToRoute = new int[levelVertical];
-		numVerticalWire = new int[levelVertical];
-		numSumVerticalWire = new int[levelVertical];
-		numActiveVerticalWire = new int[levelVertical];
-		lengthVerticalWire = new double[levelVertical];
-	}
 
 	/* When H > V */
 	int h = levelHorizontal;
@@ -442,7 +346,7 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 	mat.Initialize(numRowSubarray, numColumnSubarray, numAddressBitToRoute, matBlockSize,
 			numWay, numRowPerSet, false, numActiveSubarrayPerRow, numActiveSubarrayPerColumn,
 			muxSenseAmp, internalSenseAmp, muxOutputLev1, muxOutputLev2, areaOptimizationLevel, 
-            memoryType, stackedDieCount, partitionGranularity, monolithicStackCount);
+            memoryType, stackedDieCount, partitionGranularity, monolithicStackCount, context);
 
 	/* Check if mat is under a legal configuration */
 	if (mat.invalid) {
@@ -459,19 +363,23 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
     /* Initialize TSV connections. */
     if (stackedDieCount) {
         TSV_type tsv_type = tech->WireTypeToTSVType(inputParameter->maxGlobalWireType);
-        tsvArray.Initialize(tsv_type);
+        tsvArray.Initialize(tsv_type, stackedDieCount);
     }
 
 	initialized = true;
+	routable = true;
 }
 
 void BankWithHtree::CalculateArea() {
+	PROFILE(profile_bank_htree_area);
+	EvalContextScope scope(context);
 	if (!initialized) {
 		cout << "[Bank] Error: Require initialization first!" << endl;
 	} else if (invalid) {
 		height = width = area = invalid_value;
 	} else {
-		mat.CalculateArea();
+		if (!rerouting)
+			mat.CalculateArea();
 		height = mat.height * numRowMat;
 		width = mat.width * numColumnMat;
 
@@ -583,6 +491,8 @@ void BankWithHtree::CalculateArea() {
 }
 
 void BankWithHtree::CalculateRC() {
+	PROFILE(profile_bank_htree_rc);
+	EvalContextScope scope(context);
 	if (!initialized) {
 		cout << "[Bank] Error: Require initialization first!" << endl;
 	} else if (!invalid) {
@@ -591,6 +501,8 @@ void BankWithHtree::CalculateRC() {
 }
 
 void BankWithHtree::CalculateLatencyAndPower() {
+	PROFILE(profile_bank_htree_latency_power);
+	EvalContextScope scope(context);
 	if (!initialized) {
 		cout << "[Bank] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -603,8 +515,10 @@ void BankWithHtree::CalculateLatencyAndPower() {
 		double leakageWire;
 		int beta = 1;	/* Default value is 1. For fast access mode cache, this value is equal to associativity, which means only 1/beta interconnect wires are activated */
 
-		mat.CalculateLatency(infinite_ramp);
-		mat.CalculatePower();
+		if (!rerouting) {
+			mat.CalculateLatency(infinite_ramp);
+			mat.CalculatePower();
+		}
 		readLatency = mat.readLatency;
 		writeLatency = mat.writeLatency;
         refreshLatency = mat.refreshLatency * numColumnMat; // TOTAL refresh time for all Mats
@@ -743,6 +657,22 @@ void BankWithHtree::CalculateLatencyAndPower() {
     }
 }
 
+void BankWithHtree::Reroute() {
+	EvalContextScope scope(context);
+	if (!routable) {
+		cout << "[Bank] Error: Require a valid initialization first!" << endl;
+	} else {
+		/* Only the H-tree wires and the aspect ratio depend on the global wire */
+		invalid = false;
+		/* The unbuffered TSV adds up its energy, so start from zero as a new bank does */
+		tsvArray.readDynamicEnergy = tsvArray.writeDynamicEnergy = 0;
+		rerouting = true;
+		CalculateArea();
+		CalculateLatencyAndPower();
+		rerouting = false;
+	}
+}
+
 BankWithHtree & BankWithHtree::operator=(const BankWithHtree &rhs) {
 	Bank::operator=(rhs);
 	levelHorizontal = rhs.levelHorizontal;
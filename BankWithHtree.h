@@ -10,6 +10,7 @@
 #define BANKWITHHTREE_H_
 
 #include "Bank.h"
+#include "constant.h"
 
 class BankWithHtree: public Bank {
 public:
@@ -21,10 +22,11 @@ public:
 			int _numRowSubarray, int _numColumnSubarray,
 			int _numActiveSubarrayPerRow, int _numActiveSubarrayPerColumn,
 			BufferDesignTarget _areaOptimizationLevel, MemoryType _memoryType,
-            int _stackedDieCount, int _partitionGranularity, int monolithicStackCount);
+            int _stackedDieCount, int _partitionGranularity, int monolithicStackCount, EvalContext *_context = NULL);
 	void CalculateArea();
 	void CalculateRC();
 	void CalculateLatencyAndPower();
+	void Reroute();
 	BankWithHtree & operator=(const BankWithHtree &);
 
 	int numAddressBit;		/* Number of bank address bits */
@@ -33,20 +35,20 @@ public:
 
 	int levelHorizontal;			/* The number of horizontal levels */
 	int levelVertical;				/* The number of vertical levels */
-	int * numHorizontalAddressBitToRoute;  /* The number of horizontal bits to route on level x */
-	int * numHorizontalDataDistributeBitToRoute;	/* The number of horizontal data-in bits to route on level x */
-	int * numHorizontalDataBroadcastBitToRoute;		/* The number of horizontal data-out bits to route on level x */
-	int * numHorizontalWire;        /* The number of horizontal wire tiers on level x */
-	int * numSumHorizontalWire;     /* The number of total horizontal wire groups on level x */
-	int * numActiveHorizontalWire;  /* The number of active horizontal wire groups on level x */
-	double * lengthHorizontalWire;	/* The length of horizontal wires on level x, Unit: m */
-	int * numVerticalAddressBitToRoute;	/* The number of vertical address bits to route on level x */
-	int * numVerticalDataDistributeBitToRoute;	/* The number of vertical data-in bits to route on level x */
-	int * numVerticalDataBroadcastBitToRoute;	/* The number of vertical data-out bits to route on level x */
-	int * numVerticalWire;          /* The number of vertical wire tiers on level x */
-	int * numSumVerticalWire;       /* The number of total vertical wire groups on level x */
-    int * numActiveVerticalWire;    /* The number of active vertical wire groups on level x */
-	double * lengthVerticalWire;	/* The length of vertical wires on level x, Unit: m */
+	int numHorizontalAddressBitToRoute[MAX_HTREE_LEVEL];  /* The number of horizontal bits to route on level x */
+	int numHorizontalDataDistributeBitToRoute[MAX_HTREE_LEVEL];	/* The number of horizontal data-in bits to route on level x */
+	int numHorizontalDataBroadcastBitToRoute[MAX_HTREE_LEVEL];		/* The number of horizontal data-out bits to route on level x */
+	int numHorizontalWire[MAX_HTREE_LEVEL];        /* The number of horizontal wire tiers on level x */
+	int numSumHorizontalWire[MAX_HTREE_LEVEL];     /* The number of total horizontal wire groups on level x */
+	int numActiveHorizontalWire[MAX_HTREE_LEVEL];  /* The number of active horizontal wire groups on level x */
+	double lengthHorizontalWire[MAX_HTREE_LEVEL];	/* The length of horizontal wires on level x, Unit: m */
+	int numVerticalAddressBitToRoute[MAX_HTREE_LEVEL];	/* The number of vertical address bits to route on level x */
+	int numVerticalDataDistributeBitToRoute[MAX_HTREE_LEVEL];	/* The number of vertical data-in bits to route on level x */
+	int numVerticalDataBroadcastBitToRoute[MAX_HTREE_LEVEL];	/* The number of vertical data-out bits to route on level x */
+	int numVerticalWire[MAX_HTREE_LEVEL];          /* The number of vertical wire tiers on level x */
+	int numSumVerticalWire[MAX_HTREE_LEVEL];       /* The number of total vertical wire groups on level x */
+    int numActiveVerticalWire[MAX_HTREE_LEVEL];    /* The number of active vertical wire groups on level x */
+	double lengthVerticalWire[MAX_HTREE_LEVEL];	/* The length of vertical wires on level x, Unit: m */
 
 };
 
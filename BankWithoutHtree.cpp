@@ -9,6 +9,8 @@
 #include "BankWithoutHtree.h"
 #include "formula.h"
 #include "global.h"
+#include "EvalContext.h"
+#include "Profiler.h"
 #include <math.h>
 
 BankWithoutHtree::BankWithoutHtree() {
@@ -28,7 +30,11 @@ void BankWithoutHtree::Initialize(int _numRowMat, int _numColumnMat, long long _
 		int _numRowSubarray, int _numColumnSubarray,
 		int _numActiveSubarrayPerRow, int _numActiveSubarrayPerColumn,
 		BufferDesignTarget _areaOptimizationLevel, MemoryType _memoryType,
-        int _stackedDieCount, int _partitionGranularity, int monolithicStackCount) {
+        int _stackedDieCount, int _partitionGranularity, int monolithicStackCount, EvalContext *_context) {
+	PROFILE(profile_bank_initialize);
+	context = _context;
+	EvalContextScope scope(context);
+	routable = false;
 	if (initialized) {
 		/* Reset the class for re-initialization */
 		initialized = false;
@@ -166,7 +172,7 @@ void BankWithoutHtree::Initialize(int _numRowMat, int _numColumnMat, long long _
 	mat.Initialize(numRowSubarray, numColumnSubarray, numAddressBitRouteToMat, numDataBitRouteToMat,
 			numWay, numRowPerSet, false, numActiveSubarrayPerRow, numActiveSubarrayPerColumn,
 			muxSenseAmp, internalSenseAmp, muxOutputLev1, muxOutputLev2, areaOptimizationLevel, memoryType, 
-            stackedDieCount, partitionGranularity, monolithicStackCount);
+            stackedDieCount, partitionGranularity, monolithicStackCount, context);
 	/* Check if mat is under a legal configuration */
 	if (mat.invalid) {
 		invalid = true;
@@ -217,13 +223,16 @@ void BankWithoutHtree::Initialize(int _numRowMat, int _numColumnMat, long long _
     /* Initialize TSV connections. */
     if (stackedDieCount > 1 /*&& partitionGranularity == 0*/) {
         TSV_type tsv_type = tech->WireTypeToTSVType(inputParameter->maxGlobalWireType);
-        tsvArray.Initialize(tsv_type);
+        tsvArray.Initialize(tsv_type, stackedDieCount);
     }
 
 	initialized = true;
+	routable = true;
 }
 
 void BankWithoutHtree::CalculateArea() {
+	PROFILE(profile_bank_area);
+	EvalContextScope scope(context);
 	if (!initialized) {
 		cout << "[BankWithoutHtree] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -292,6 +301,8 @@ void BankWithoutHtree::CalculateArea() {
 }
 
 void BankWithoutHtree::CalculateRC() {
+	PROFILE(profile_bank_rc);
+	EvalContextScope scope(context);
 	if (!initialized) {
 		cout << "[BankWithoutHtree] Error: Require initialization first!" << endl;
 	} else if (!invalid) {
@@ -306,6 +317,8 @@ void BankWithoutHtree::CalculateRC() {
 }
 
 void BankWithoutHtree::CalculateLatencyAndPower() {
+	PROFILE(profile_bank_latency_power);
+	EvalContextScope scope(context);
 	if (!initialized) {
 		cout << "[BankWithoutHtree] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -317,8 +330,10 @@ void BankWithoutHtree::CalculateLatencyAndPower() {
 		double energy = 0;
 		double leakageWire = 0;
 
-		mat.CalculateLatency(infinite_ramp);
-		mat.CalculatePower();
+		if (!rerouting) {
+			mat.CalculateLatency(infinite_ramp);
+			mat.CalculatePower();
+		}
 		readLatency = resetLatency = setLatency = writeLatency = 0;
         refreshLatency = mat.refreshLatency * numColumnMat; // TOTAL refresh time for all Mats
 		readDynamicEnergy = writeDynamicEnergy = resetDynamicEnergy = setDynamicEnergy = 0;
@@ -545,6 +560,22 @@ void BankWithoutHtree::CalculateLatencyAndPower() {
     }
 }
 
+void BankWithoutHtree::Reroute() {
+	EvalContextScope scope(context);
+	if (!routable) {
+		cout << "[BankWithoutHtree] Error: Require a valid initialization first!" << endl;
+	} else {
+		/* Only the global wires, the aspect ratio and the external sensing depend on the global wire */
+		invalid = !internalSenseAmp && globalWire->wireRepeaterType != repeated_none;
+		/* The unbuffered TSV adds up its energy, so start from zero as a new bank does */
+		tsvArray.readDynamicEnergy = tsvArray.writeDynamicEnergy = 0;
+		rerouting = true;
+		CalculateArea();
+		CalculateLatencyAndPower();
+		rerouting = false;
+	}
+}
+
 BankWithoutHtree & BankWithoutHtree::operator=(const BankWithoutHtree &rhs) {
 	Bank::operator=(rhs);
 	numAddressBit = rhs.numAddressBit;
@@ -26,10 +26,11 @@ public:
 			int _numRowSubarray, int _numColumnSubarray,
 			int _numActiveSubarrayPerRow, int _numActiveSubarrayPerColumn,
 			BufferDesignTarget _areaOptimizationLevel, MemoryType _memoryType,
-            int _stackedDieCount, int _partitionGranularity, int monolithicStackCount);
+            int _stackedDieCount, int _partitionGranularity, int monolithicStackCount, EvalContext *_context = NULL);
 	void CalculateArea();
 	void CalculateRC();
 	void CalculateLatencyAndPower();
+	void Reroute();
 	BankWithoutHtree & operator=(const BankWithoutHtree &);
 
 	int numAddressBit;		   /* Number of bank address bits */
@@ -7,6 +7,7 @@
 #include "BasicDecoder.h"
 #include "formula.h"
 #include "global.h"
+#include "Profiler.h"
 
 BasicDecoder::BasicDecoder() {
 	// TODO Auto-generated constructor stub
@@ -18,6 +19,7 @@ BasicDecoder::~BasicDecoder() {
 }
 
 void BasicDecoder::Initialize(int _numAddressBit, double _capLoad, double _resLoad){
+	PROFILE(profile_decoder_initialize);
 	/*if (initialized)
 			cout << "Warning: Already initialized!" << endl;*/
 	/* might be re-initialized by predecodeblock */
@@ -58,6 +60,7 @@ void BasicDecoder::Initialize(int _numAddressBit, double _capLoad, double _resLo
 }
 
 void BasicDecoder::CalculateArea() {
+	PROFILE(profile_decoder_area);
 	if (!initialized) {
 		cout << "[Basic Decoder] Error: Require initialization first!" << endl;
 	} else {
@@ -78,6 +81,7 @@ void BasicDecoder::CalculateArea() {
 }
 
 void BasicDecoder::CalculateRC() {
+	PROFILE(profile_decoder_rc);
 	if (!initialized) {
 		cout << "[Basic Decoder] Error: Require initialization first!" << endl;
 	} else {
@@ -89,6 +93,7 @@ void BasicDecoder::CalculateRC() {
 }
 
 void BasicDecoder::CalculateLatency(double _rampInput) {
+	PROFILE(profile_decoder_latency);
 	if (!initialized) {
 		cout << "[Basic Decoder] Error: Require initialization first!" << endl;
 	} else {
@@ -121,6 +126,7 @@ void BasicDecoder::CalculateLatency(double _rampInput) {
 }
 
 void BasicDecoder::CalculatePower() {
+	PROFILE(profile_decoder_power);
 	if (!initialized) {
 		cout << "[Basic Decoder] Error: Require initialization first!" << endl;
 	} else {
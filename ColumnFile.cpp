@@ -0,0 +1,257 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "ColumnFile.h"
+#include <cstring>
+#include <cstddef>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define ALIGN_8(x)	(((x) + 7) / 8 * 8)
+
+static void AddColumn(vector<ColumnDescription> &columns, const string &name, ColumnType type, size_t offset) {
+	ColumnDescription column;
+	memset(&column, 0, sizeof(column));
+	strncpy(column.name, name.c_str(), COLUMN_NAME_LENGTH - 1);
+	column.type = type;
+	column.offset = offset;
+	columns.push_back(column);
+}
+
+#define INT_COLUMN(record, field) \
+	AddColumn(columns, prefix + #field, column_int32, base + offsetof(record, field))
+#define FLOAT_COLUMN(record, field) \
+	AddColumn(columns, prefix + #field, column_float64, base + offsetof(record, field))
+
+static void AddDesignColumns(vector<ColumnDescription> &columns, const string &prefix, size_t base) {
+	INT_COLUMN(DesignRecord, numRowMat);
+	INT_COLUMN(DesignRecord, numColumnMat);
+	INT_COLUMN(DesignRecord, stackedDieCount);
+	INT_COLUMN(DesignRecord, numActiveMatPerColumn);
+	INT_COLUMN(DesignRecord, numActiveMatPerRow);
+	INT_COLUMN(DesignRecord, numRowSubarray);
+	INT_COLUMN(DesignRecord, numColumnSubarray);
+	INT_COLUMN(DesignRecord, numActiveSubarrayPerColumn);
+	INT_COLUMN(DesignRecord, numActiveSubarrayPerRow);
+	INT_COLUMN(DesignRecord, numRowPerSubarray);
+	INT_COLUMN(DesignRecord, numColumnPerSubarray);
+	INT_COLUMN(DesignRecord, muxSenseAmp);
+	INT_COLUMN(DesignRecord, muxOutputLev1);
+	INT_COLUMN(DesignRecord, muxOutputLev2);
+	INT_COLUMN(DesignRecord, numRowPerSet);
+	INT_COLUMN(DesignRecord, localWireType);
+	INT_COLUMN(DesignRecord, localWireRepeaterType);
+	INT_COLUMN(DesignRecord, localWireLowSwing);
+	INT_COLUMN(DesignRecord, globalWireType);
+	INT_COLUMN(DesignRecord, globalWireRepeaterType);
+	INT_COLUMN(DesignRecord, globalWireLowSwing);
+	INT_COLUMN(DesignRecord, areaOptimizationLevel);
+	FLOAT_COLUMN(DesignRecord, height);
+	FLOAT_COLUMN(DesignRecord, width);
+	FLOAT_COLUMN(DesignRecord, area);
+	FLOAT_COLUMN(DesignRecord, matHeight);
+	FLOAT_COLUMN(DesignRecord, matWidth);
+	FLOAT_COLUMN(DesignRecord, matArea);
+	FLOAT_COLUMN(DesignRecord, subarrayHeight);
+	FLOAT_COLUMN(DesignRecord, subarrayWidth);
+	FLOAT_COLUMN(DesignRecord, subarrayArea);
+	FLOAT_COLUMN(DesignRecord, areaEfficiency);
+	FLOAT_COLUMN(DesignRecord, readLatency);
+	FLOAT_COLUMN(DesignRecord, writeLatency);
+	FLOAT_COLUMN(DesignRecord, refreshLatency);
+	FLOAT_COLUMN(DesignRecord, readDynamicEnergy);
+	FLOAT_COLUMN(DesignRecord, writeDynamicEnergy);
+	FLOAT_COLUMN(DesignRecord, refreshDynamicEnergy);
+	FLOAT_COLUMN(DesignRecord, leakage);
+	FLOAT_COLUMN(DesignRecord, refreshPower);
+}
+
+void BuildColumnSchema(bool isCache, vector<ColumnDescription> &columns) {
+	columns.clear();
+	if (!isCache) {
+		AddDesignColumns(columns, "", 0);
+		return;
+	}
+	string prefix = "";
+	size_t base = 0;
+	INT_COLUMN(CacheDesignRecord, cacheAccessMode);
+	INT_COLUMN(CacheDesignRecord, tagOptimizationTarget);
+	FLOAT_COLUMN(CacheDesignRecord, area);
+	FLOAT_COLUMN(CacheDesignRecord, hitLatency);
+	FLOAT_COLUMN(CacheDesignRecord, missLatency);
+	FLOAT_COLUMN(CacheDesignRecord, writeLatency);
+	FLOAT_COLUMN(CacheDesignRecord, refreshLatency);
+	FLOAT_COLUMN(CacheDesignRecord, hitDynamicEnergy);
+	FLOAT_COLUMN(CacheDesignRecord, missDynamicEnergy);
+	FLOAT_COLUMN(CacheDesignRecord, writeDynamicEnergy);
+	FLOAT_COLUMN(CacheDesignRecord, refreshDynamicEnergy);
+	FLOAT_COLUMN(CacheDesignRecord, leakage);
+	FLOAT_COLUMN(CacheDesignRecord, refreshPower);
+	FLOAT_COLUMN(CacheDesignRecord, subarrayLeakage);
+	FLOAT_COLUMN(CacheDesignRecord, subarrayArea);
+	AddDesignColumns(columns, "data.", offsetof(CacheDesignRecord, data));
+	AddDesignColumns(columns, "tag.", offsetof(CacheDesignRecord, tag));
+}
+
+static size_t ColumnWidth(uint32_t type) {
+	return (type == column_int32) ? sizeof(int32_t) : sizeof(double);
+}
+
+ColumnFileWriter::ColumnFileWriter() {
+	target = NULL;
+	recordSize = 0;
+}
+
+ColumnFileWriter::~ColumnFileWriter() {
+	Close();
+}
+
+void ColumnFileWriter::Open(ostream *_target, bool _isCache) {
+	Close();
+	target = _target;
+	BuildColumnSchema(_isCache, columns);
+	recordSize = _isCache ? sizeof(CacheDesignRecord) : sizeof(DesignRecord);
+	rows.clear();
+	rows.reserve(COLUMN_CHUNK_ROWS * recordSize);
+
+	ColumnFileHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, COLUMN_FILE_MAGIC, sizeof(header.magic));
+	header.version = COLUMN_FILE_VERSION;
+	header.numColumn = columns.size();
+	header.recordSize = recordSize;
+	header.isCache = _isCache;
+	target->write((const char *)&header, sizeof(header));
+	target->write((const char *)columns.data(), columns.size() * sizeof(ColumnDescription));
+}
+
+void ColumnFileWriter::Close() {
+	if (!target)
+		return;
+	if (rows.size() >= recordSize)
+		WriteChunk(rows.size() / recordSize);
+	target->flush();
+	target = NULL;
+}
+
+int ColumnFileWriter::overflow(int c) {
+	if (c != EOF) {
+		char ch = c;
+		xsputn(&ch, 1);
+	}
+	return c;
+}
+
+streamsize ColumnFileWriter::xsputn(const char *s, streamsize n) {
+	rows.append(s, n);
+	while (rows.size() >= COLUMN_CHUNK_ROWS * recordSize)
+		WriteChunk(COLUMN_CHUNK_ROWS);
+	return n;
+}
+
+void ColumnFileWriter::WriteChunk(uint64_t numRow) {
+	ColumnChunkHeader header;
+	header.numRow = numRow;
+	target->write((const char *)&header, sizeof(header));
+	for (int col = 0; col < (int)columns.size(); col++) {
+		size_t width = ColumnWidth(columns[col].type);
+		column.assign(ALIGN_8(numRow * width), 0);
+		const char *record = rows.data() + columns[col].offset;
+		for (uint64_t row = 0; row < numRow; row++, record += recordSize)
+			memcpy(&column[row * width], record, width);
+		target->write(column.data(), column.size());
+	}
+	rows.erase(0, numRow * recordSize);
+}
+
+ColumnFileReader::ColumnFileReader() {
+	isCache = false;
+	numRow = 0;
+	data = NULL;
+	size = 0;
+}
+
+ColumnFileReader::~ColumnFileReader() {
+	Close();
+}
+
+bool ColumnFileReader::Open(const string &fileName) {
+	Close();
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat status;
+	if (fstat(fd, &status) || status.st_size < (off_t)sizeof(ColumnFileHeader)) {
+		close(fd);
+		return false;
+	}
+	size = status.st_size;
+	void *mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED) {
+		size = 0;
+		return false;
+	}
+	data = (const char *)mapped;
+
+	const ColumnFileHeader *header = (const ColumnFileHeader *)data;
+	size_t position = sizeof(ColumnFileHeader) + (size_t)header->numColumn * sizeof(ColumnDescription);
+	if (memcmp(header->magic, COLUMN_FILE_MAGIC, sizeof(header->magic)) || header->version != COLUMN_FILE_VERSION
+			|| position > size) {
+		Close();
+		return false;
+	}
+	isCache = header->isCache;
+	const ColumnDescription *description = (const ColumnDescription *)(data + sizeof(ColumnFileHeader));
+	columns.assign(description, description + header->numColumn);
+
+	while (position + sizeof(ColumnChunkHeader) <= size) {
+		uint64_t numChunkRow = ((const ColumnChunkHeader *)(data + position))->numRow;
+		position += sizeof(ColumnChunkHeader);
+		vector<const char *> chunk;
+		for (int col = 0; col < (int)columns.size(); col++) {
+			chunk.push_back(data + position);
+			position += ALIGN_8(numChunkRow * ColumnWidth(columns[col].type));
+		}
+		if (position > size)
+			break;		/* Incomplete chunk at the end of a file that is still being written */
+		chunkRows.push_back(numChunkRow);
+		chunkColumns.push_back(chunk);
+		numRow += numChunkRow;
+	}
+	return true;
+}
+
+void ColumnFileReader::Close() {
+	if (data)
+		munmap((void *)data, size);
+	data = NULL;
+	size = 0;
+	isCache = false;
+	numRow = 0;
+	columns.clear();
+	chunkRows.clear();
+	chunkColumns.clear();
+}
+
+int ColumnFileReader::FindColumn(const string &name) const {
+	for (int col = 0; col < (int)columns.size(); col++)
+		if (name == columns[col].name)
+			return col;
+	return -1;
+}
+
+const void * ColumnFileReader::Column(int chunk, int col) const {
+	return chunkColumns[chunk][col];
+}
+
+double ColumnFileReader::Value(int chunk, int col, uint64_t row) const {
+	if (columns[col].type == column_int32)
+		return ((const int32_t *)chunkColumns[chunk][col])[row];
+	return ((const double *)chunkColumns[chunk][col])[row];
+}
@@ -0,0 +1,170 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef COLUMNFILE_H_
+#define COLUMNFILE_H_
+
+#include <stdint.h>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/* The binary output file of -OutputFormat: binary, see ColumnFileWriter for the layout */
+#define COLUMN_FILE_MAGIC		"DESTINYC"
+#define COLUMN_FILE_VERSION		1
+#define COLUMN_NAME_LENGTH		48
+#define COLUMN_CHUNK_ROWS		65536	/* Maximum number of rows in a chunk */
+
+enum ColumnType
+{
+	column_int32 = 0,
+	column_float64 = 1
+};
+
+struct ColumnFileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t numColumn;		/* Number of ColumnDescription that follow the header */
+	uint32_t recordSize;	/* Size of the row records that the file is built from, Unit: byte */
+	uint32_t isCache;		/* Whether the rows are CacheDesignRecord or DesignRecord */
+};
+
+struct ColumnDescription {
+	char name[COLUMN_NAME_LENGTH];
+	uint32_t type;			/* actually ColumnType */
+	uint32_t offset;		/* Offset of the column in a row record, Unit: byte */
+};
+
+struct ColumnChunkHeader {
+	uint64_t numRow;
+};
+
+/* A design as it is written to the binary output file, all the values are in SI units.
+ * The enumerations are stored as their values in typedef.h */
+struct DesignRecord {
+	int32_t numRowMat;
+	int32_t numColumnMat;
+	int32_t stackedDieCount;
+	int32_t numActiveMatPerColumn;
+	int32_t numActiveMatPerRow;
+	int32_t numRowSubarray;
+	int32_t numColumnSubarray;
+	int32_t numActiveSubarrayPerColumn;
+	int32_t numActiveSubarrayPerRow;
+	int32_t numRowPerSubarray;
+	int32_t numColumnPerSubarray;
+	int32_t muxSenseAmp;
+	int32_t muxOutputLev1;
+	int32_t muxOutputLev2;
+	int32_t numRowPerSet;			/* -1 if it is not a cache */
+	int32_t localWireType;			/* actually WireType */
+	int32_t localWireRepeaterType;	/* actually WireRepeaterType */
+	int32_t localWireLowSwing;
+	int32_t globalWireType;
+	int32_t globalWireRepeaterType;
+	int32_t globalWireLowSwing;
+	int32_t areaOptimizationLevel;	/* actually BufferDesignTarget */
+	double height;
+	double width;
+	double area;
+	double matHeight;
+	double matWidth;
+	double matArea;
+	double subarrayHeight;
+	double subarrayWidth;
+	double subarrayArea;
+	double areaEfficiency;			/* Unit: % */
+	double readLatency;
+	double writeLatency;
+	double refreshLatency;			/* 0 if it is not eDRAM */
+	double readDynamicEnergy;
+	double writeDynamicEnergy;
+	double refreshDynamicEnergy;	/* 0 if it is not eDRAM */
+	double leakage;
+	double refreshPower;			/* 0 if it is not eDRAM */
+};
+
+/* A cache design, the data array with one of the best tag arrays */
+struct CacheDesignRecord {
+	int32_t cacheAccessMode;		/* actually CacheAccessMode */
+	int32_t tagOptimizationTarget;	/* The target that the tag array is the best one for, actually OptimizationTarget */
+	double area;
+	double hitLatency;
+	double missLatency;
+	double writeLatency;
+	double refreshLatency;
+	double hitDynamicEnergy;
+	double missDynamicEnergy;
+	double writeDynamicEnergy;
+	double refreshDynamicEnergy;
+	double leakage;
+	double refreshPower;
+	double subarrayLeakage;			/* Data and tag subarrays together */
+	double subarrayArea;
+	DesignRecord data;
+	DesignRecord tag;
+};
+
+void BuildColumnSchema(bool isCache, vector<ColumnDescription> &columns);
+
+/* The stream buffer that the row records of the designs are written to. It collects them into chunks of at
+ * most COLUMN_CHUNK_ROWS rows and writes every chunk column by column. The file is
+ *   ColumnFileHeader, ColumnDescription * numColumn,
+ *   then for every chunk: ColumnChunkHeader, then every column as numRow values,
+ *   each column padded to 8 bytes,
+ * so every column starts at an offset that is aligned for its type and the file can be mapped as it is */
+class ColumnFileWriter : public streambuf {
+public:
+	ColumnFileWriter();
+	virtual ~ColumnFileWriter();
+
+	/* Functions */
+	void Open(ostream *_target, bool _isCache);
+	void Close();	/* Write the last chunk */
+
+protected:
+	virtual int overflow(int c);
+	virtual streamsize xsputn(const char *s, streamsize n);
+
+private:
+	void WriteChunk(uint64_t numRow);
+
+	ostream *target;
+	vector<ColumnDescription> columns;
+	size_t recordSize;
+	string rows;		/* Row records that are not written yet, the last one can be incomplete */
+	vector<char> column;
+};
+
+/* Maps a binary output file and gives the columns of each chunk */
+class ColumnFileReader {
+public:
+	ColumnFileReader();
+	virtual ~ColumnFileReader();
+
+	/* Functions */
+	bool Open(const string &fileName);	/* false if the file can not be mapped or is not a binary output file */
+	void Close();
+	int FindColumn(const string &name) const;	/* -1 if there is no such column */
+	const void * Column(int chunk, int col) const;	/* The values of a column in a chunk */
+	double Value(int chunk, int col, uint64_t row) const;
+
+	/* Properties */
+	bool isCache;
+	vector<ColumnDescription> columns;
+	vector<uint64_t> chunkRows;		/* Number of rows of each chunk */
+	uint64_t numRow;
+
+private:
+	const char *data;
+	size_t size;
+	vector<vector<const char *> > chunkColumns;	/* Where each column of each chunk starts */
+};
+
+#endif /* COLUMNFILE_H_ */
@@ -8,6 +8,7 @@
 #include "Comparator.h"
 #include "global.h"
 #include "formula.h"
+#include "Profiler.h"
 #include <math.h>
 
 Comparator::Comparator() {
@@ -23,6 +24,7 @@ Comparator::~Comparator() {
 }
 
 void Comparator::Initialize(int _numTagBits, double _capLoad){
+	PROFILE(profile_comparator_initialize);
 	if (initialized)
 		cout << "[Comparator] Warning: Already initialized!" << endl;
 
@@ -43,6 +45,7 @@ void Comparator::Initialize(int _numTagBits, double _capLoad){
 }
 
 void Comparator::CalculateArea() {
+	PROFILE(profile_comparator_area);
 	if (!initialized) {
 		cout << "[Comparator] Error: Require initialization first!" << endl;
 	} else {
@@ -64,6 +67,7 @@ void Comparator::CalculateArea() {
 }
 
 void Comparator::CalculateRC() {
+	PROFILE(profile_comparator_rc);
 	if (!initialized) {
 		cout << "[Comparator] Error: Require initialization first!" << endl;
 	} else {
@@ -80,6 +84,7 @@ void Comparator::CalculateRC() {
 }
 
 void Comparator::CalculateLatency(double _rampInput) {
+	PROFILE(profile_comparator_latency);
 	if (!initialized) {
 		cout << "[Comparator] Error: Require initialization first!" << endl;
 	} else {
@@ -108,6 +113,7 @@ void Comparator::CalculateLatency(double _rampInput) {
 }
 
 void Comparator::CalculatePower() {
+	PROFILE(profile_comparator_power);
 	if (!initialized) {
 		cout << "[Comparator] Error: Require initialization first!" << endl;
 	} else {
@@ -0,0 +1,133 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "CsvWriter.h"
+#include <charconv>
+
+CsvWriter::CsvWriter() {
+	target = NULL;
+	background = false;
+	closing = false;
+}
+
+CsvWriter::~CsvWriter() {
+	Close();
+}
+
+void CsvWriter::Open(ostream *_target, bool _background) {
+	Close();
+	target = _target;
+	background = _background && target;
+	closing = false;
+	buffer.reserve(CSV_BUFFER_SIZE + CSV_BUFFER_SIZE / 4);
+	if (background)
+		writer = thread(&CsvWriter::WriteQueue, this);
+}
+
+void CsvWriter::Close() {
+	if (!target)
+		return;
+	Flush();
+	if (background) {
+		{
+			lock_guard<mutex> lock(queueMutex);
+			closing = true;
+		}
+		queueCondition.notify_all();
+		writer.join();
+		background = false;
+	}
+	target->flush();
+	target = NULL;
+}
+
+void CsvWriter::Write(const string &data) {
+	Write(data.data(), data.size());
+}
+
+void CsvWriter::Write(const char *data, size_t size) {
+	buffer.append(data, size);
+	if (buffer.size() >= CSV_BUFFER_SIZE)
+		Flush();
+}
+
+string CsvWriter::Take() {
+	string data;
+	data.swap(buffer);
+	return data;
+}
+
+void CsvWriter::Flush() {
+	if (!target || buffer.empty())
+		return;
+	if (!background) {
+		target->write(buffer.data(), buffer.size());
+		buffer.clear();
+		return;
+	}
+	unique_lock<mutex> lock(queueMutex);
+	queueCondition.wait(lock, [this]() { return queue.size() < CSV_QUEUE_LENGTH; });
+	queue.push_back(string());
+	queue.back().swap(buffer);
+	lock.unlock();
+	queueCondition.notify_all();
+	buffer.reserve(CSV_BUFFER_SIZE + CSV_BUFFER_SIZE / 4);
+}
+
+void CsvWriter::WriteQueue() {
+	unique_lock<mutex> lock(queueMutex);
+	while (true) {
+		queueCondition.wait(lock, [this]() { return closing || !queue.empty(); });
+		if (queue.empty())
+			return;		/* closing */
+		string data;
+		data.swap(queue.front());
+		queue.pop_front();
+		lock.unlock();
+		queueCondition.notify_all();
+		target->write(data.data(), data.size());
+		lock.lock();
+	}
+}
+
+CsvWriter & CsvWriter::operator<<(const char *value) {
+	buffer += value;
+	if (buffer.size() >= CSV_BUFFER_SIZE)
+		Flush();
+	return *this;
+}
+
+CsvWriter & CsvWriter::operator<<(const string &value) {
+	return *this << value.c_str();
+}
+
+CsvWriter & CsvWriter::operator<<(char value) {
+	buffer += value;
+	return *this;
+}
+
+CsvWriter & CsvWriter::operator<<(int value) {
+	return *this << (long long)value;
+}
+
+CsvWriter & CsvWriter::operator<<(long value) {
+	return *this << (long long)value;
+}
+
+CsvWriter & CsvWriter::operator<<(long long value) {
+	char text[24];
+	to_chars_result result = to_chars(text, text + sizeof(text), value);
+	buffer.append(text, result.ptr - text);
+	return *this;
+}
+
+CsvWriter & CsvWriter::operator<<(double value) {
+	/* The default format of ostream is %g with 6 significant digits */
+	char text[32];
+	to_chars_result result = to_chars(text, text + sizeof(text), value, chars_format::general, 6);
+	buffer.append(text, result.ptr - text);
+	return *this;
+}
@@ -0,0 +1,65 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef CSVWRITER_H_
+#define CSVWRITER_H_
+
+#include <ostream>
+#include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+
+#define CSV_BUFFER_SIZE		(1 << 20)	/* The buffer is handed to the target when it grows beyond this, Unit: byte */
+#define CSV_QUEUE_LENGTH	4			/* Number of full buffers that wait for the background thread at most */
+
+/* The sink of the csv output file. The designs are formatted into a large buffer, numbers in the same
+ * format as the default format of ostream but without going through the locale. The buffer is written to
+ * the target stream when it is full, on a background thread if it is enabled. A writer without a target
+ * keeps everything in memory until Take is called. The row records of -OutputFormat: binary go through
+ * Write as they are */
+class CsvWriter {
+public:
+	CsvWriter();
+	virtual ~CsvWriter();
+
+	/* Functions */
+	void Open(ostream *_target, bool _background);
+	void Close();	/* Write everything that is buffered and stop the background thread */
+	void Write(const string &data);
+	void Write(const char *data, size_t size);
+	string Take();	/* Return and clear everything that is buffered */
+
+	CsvWriter & operator<<(const char *value);
+	CsvWriter & operator<<(const string &value);
+	CsvWriter & operator<<(char value);
+	CsvWriter & operator<<(int value);
+	CsvWriter & operator<<(long value);
+	CsvWriter & operator<<(long long value);
+	CsvWriter & operator<<(double value);
+
+private:
+	CsvWriter(const CsvWriter &);
+	CsvWriter & operator=(const CsvWriter &);
+
+	void Flush();
+	void WriteQueue();	/* Body of the background thread */
+
+	string buffer;
+	ostream *target;	/* NULL if the output is kept in memory */
+	bool background;
+
+	thread writer;
+	mutex queueMutex;
+	condition_variable queueCondition;
+	deque<string> queue;	/* Full buffers that are not written yet */
+	bool closing;
+};
+
+#endif /* CSVWRITER_H_ */
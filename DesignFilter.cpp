@@ -0,0 +1,305 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "DesignFilter.h"
+#include "global.h"
+#include "constant.h"
+#include "formula.h"
+#include <math.h>
+
+static const char *reasonNames[num_reject_reason] = {
+	"H-tree routing",
+	"rows per set",
+	"tag ways",
+	"mat address bits",
+	"subarray rows",
+	"subarray columns",
+	"associativity",
+	"DRAM bitline mux",
+	"NAND pages",
+	"sense amp mux",
+	"bitline leakage",
+	"row predecoder"
+};
+
+DesignFilter::DesignFilter() {
+	enabled = false;
+	for (int i = 0; i < num_reject_reason; i++)
+		numRejected[i] = 0;
+}
+
+DesignFilter::~DesignFilter() {
+	// TODO Auto-generated destructor stub
+}
+
+void DesignFilter::Initialize() {
+	enabled = inputParameter->internalSensing;
+	for (int i = 0; i < num_reject_reason; i++)
+		numRejected[i] = 0;
+}
+
+bool DesignFilter::Reject(int numRowMat, int numColumnMat, long long capacity, long blockSize, int associativity,
+		int numRowPerSet, int numActiveMatPerRow, int numActiveMatPerColumn, int muxSenseAmp,
+		int muxOutputLev1, int muxOutputLev2, int numRowSubarray, int numColumnSubarray,
+		int numActiveSubarrayPerRow, int numActiveSubarrayPerColumn, MemoryType memoryType,
+		int stackedDieCount) {
+	if (!enabled)
+		return false;
+
+	int numAddressBit, numWay;
+	long numDataBit;
+	RejectReason reason;
+	if (inputParameter->routingMode == h_tree)
+		reason = CheckHtree(numRowMat, numColumnMat, capacity, blockSize, associativity, numRowPerSet,
+				numActiveMatPerRow, numActiveMatPerColumn, muxSenseAmp, muxOutputLev1, muxOutputLev2, memoryType,
+				stackedDieCount, numAddressBit, numDataBit, numWay);
+	else
+		reason = CheckWithoutHtree(numRowMat, numColumnMat, capacity, blockSize, associativity, numRowPerSet,
+				numActiveMatPerRow, numActiveMatPerColumn, muxSenseAmp, muxOutputLev1, muxOutputLev2, memoryType,
+				stackedDieCount, numAddressBit, numDataBit, numWay);
+	if (reason == num_reject_reason)
+		reason = CheckMat(numRowSubarray, numColumnSubarray, numAddressBit, numDataBit, numWay,
+				numActiveSubarrayPerRow, numActiveSubarrayPerColumn, muxSenseAmp, muxOutputLev1, muxOutputLev2, memoryType);
+	if (reason == num_reject_reason)
+		return false;
+	numRejected[reason]++;
+	return true;
+}
+
+/* Same as the mux recalculation of the banks for the ways of a set that share a row */
+void DesignFilter::AddWayMux(int numWayPerRow, int &muxSenseAmp, int &muxOutputLev1, int &muxOutputLev2) const {
+	int numWayPerRowInLog = (int)(log2((double)numWayPerRow) + 0.1);
+	if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+		int extraMuxOutputLev2 = (int)pow(2, numWayPerRowInLog / 2);
+		int extraMuxOutputLev1 = numWayPerRow / extraMuxOutputLev2;
+		muxOutputLev1 *= extraMuxOutputLev1;
+		muxOutputLev2 *= extraMuxOutputLev2;
+	} else {
+		int extraMuxOutputLev2 = (int)pow(2, numWayPerRowInLog / 3);
+		int extraMuxOutputLev1 = extraMuxOutputLev2;
+		int extraMuxSenseAmp = numWayPerRow / extraMuxOutputLev1 / extraMuxOutputLev2;
+		muxSenseAmp *= extraMuxSenseAmp;
+		muxOutputLev1 *= extraMuxOutputLev1;
+		muxOutputLev2 *= extraMuxOutputLev2;
+	}
+}
+
+/* One level of the H-tree either splits the data bits between the active mats or uses up an address bit,
+ * false if there is nothing left to route */
+static bool RouteLevel(int &numDataDistributeBit, int numDataBroadcastBit, int &numAddressBit, int &toActive) {
+	if (numDataDistributeBit + numDataBroadcastBit == 0 || numAddressBit == 0)
+		return false;
+	if (toActive > 1) {
+		numDataDistributeBit /= 2;
+		toActive /= 2;
+	} else {
+		numAddressBit--;
+	}
+	return true;
+}
+
+/* Same as BankWithHtree::Initialize up to the mat, only the bits that are left at the mats are followed */
+RejectReason DesignFilter::CheckHtree(int numRowMat, int numColumnMat, long long capacity, long blockSize, int associativity,
+		int numRowPerSet, int numActiveMatPerRow, int numActiveMatPerColumn, int &muxSenseAmp,
+		int &muxOutputLev1, int &muxOutputLev2, MemoryType memoryType, int stackedDieCount,
+		int &numAddressBit, long &numDataBit, int &numWay) const {
+	if (stackedDieCount > 1)
+		numAddressBit = (int)(log2((double)capacity / blockSize / associativity / stackedDieCount) + 0.1);
+	else
+		numAddressBit = (int)(log2((double)capacity / blockSize / associativity) + 0.1);
+
+	int numDataDistributeBit, numDataBroadcastBit;
+	if (memoryType == MemoryType::data) {
+		numDataDistributeBit = blockSize;
+		numDataBroadcastBit = (int)(log2(associativity));
+	} else if (memoryType == tag) {
+		numDataDistributeBit = associativity;
+		numDataBroadcastBit = blockSize;
+	} else {
+		numDataDistributeBit = 0;
+		numDataBroadcastBit = blockSize;
+	}
+
+	int levelHorizontal = (int)(log2(numColumnMat)+0.1);
+	int levelVertical = (int)(log2(numRowMat)+0.1);
+	int h = levelHorizontal;
+	int v = levelVertical;
+	int rowToActive = MIN(numActiveMatPerColumn, numRowMat);
+	int columnToActive = MIN(numActiveMatPerRow, numColumnMat);
+
+	if (h > 0) {
+		if (numDataDistributeBit + numDataBroadcastBit == 0 || numAddressBit == 0)
+			return reject_htree_routing;
+		h--;
+	}
+	while (h > v) {
+		if (!RouteLevel(numDataDistributeBit, numDataBroadcastBit, numAddressBit, columnToActive))
+			return reject_htree_routing;
+		h--;
+	}
+	while (v > h) {
+		if (!RouteLevel(numDataDistributeBit, numDataBroadcastBit, numAddressBit, rowToActive))
+			return reject_htree_routing;
+		v--;
+	}
+	while (h > 0) {
+		if (!RouteLevel(numDataDistributeBit, numDataBroadcastBit, numAddressBit, columnToActive))
+			return reject_htree_routing;
+		if (!RouteLevel(numDataDistributeBit, numDataBroadcastBit, numAddressBit, rowToActive))
+			return reject_htree_routing;
+		h--;
+		v--;
+	}
+	if (numDataDistributeBit + numDataBroadcastBit == 0 || numAddressBit == 0)
+		return reject_htree_routing;
+	if (columnToActive > 1)
+		numDataDistributeBit /= 2;
+	else if (levelHorizontal > 0)
+		numAddressBit--;
+
+	if (memoryType == MemoryType::data) {
+		if (numRowPerSet > (int)pow(2, numDataBroadcastBit))
+			return reject_row_per_set;
+		numDataBit = numDataDistributeBit;
+		numWay = (int)pow(2, numDataBroadcastBit);
+		int numWayPerRow = numWay / numRowPerSet;
+		if (numWayPerRow > 1)
+			AddWayMux(numWayPerRow, muxSenseAmp, muxOutputLev1, muxOutputLev2);
+	} else if (memoryType == tag) {
+		if (numRowPerSet > 1)
+			return reject_row_per_set;
+		if (numDataDistributeBit == 0)
+			return reject_tag_way;
+		numDataBit = numDataBroadcastBit;
+		numWay = numDataDistributeBit;
+	} else {
+		numDataBit = numDataBroadcastBit;
+		numWay = 1;
+	}
+	return num_reject_reason;
+}
+
+/* Same as BankWithoutHtree::Initialize up to the mat */
+RejectReason DesignFilter::CheckWithoutHtree(int numRowMat, int numColumnMat, long long capacity, long blockSize, int associativity,
+		int numRowPerSet, int numActiveMatPerRow, int numActiveMatPerColumn, int &muxSenseAmp,
+		int &muxOutputLev1, int &muxOutputLev2, MemoryType memoryType, int stackedDieCount,
+		int &numAddressBit, long &numDataBit, int &numWay) const {
+	if (stackedDieCount > 1)
+		numAddressBit = (int)(log2((double)capacity / blockSize / associativity / stackedDieCount) + 0.1);
+	else
+		numAddressBit = (int)(log2((double)capacity / blockSize / associativity) + 0.1);
+	numActiveMatPerRow = MIN(numActiveMatPerRow, numColumnMat);
+	numActiveMatPerColumn = MIN(numActiveMatPerColumn, numRowMat);
+	numAddressBit -= (int)(log2(numRowMat * numColumnMat / numActiveMatPerColumn / numActiveMatPerRow)+0.1);
+
+	if (memoryType == MemoryType::data) {
+		numDataBit = blockSize / numActiveMatPerColumn / numActiveMatPerRow;
+		if (numRowPerSet > associativity)
+			return reject_row_per_set;
+		numWay = associativity;
+		int numWayPerRow = numWay / numRowPerSet;
+		if (numWayPerRow > 1)
+			AddWayMux(numWayPerRow, muxSenseAmp, muxOutputLev1, muxOutputLev2);
+	} else if (memoryType == tag) {
+		if (numRowPerSet > 1)
+			return reject_row_per_set;
+		numDataBit = blockSize;
+		numWay = associativity / numActiveMatPerColumn / numActiveMatPerRow;
+		if (numWay < 1)
+			return reject_tag_way;
+	} else {
+		numDataBit = blockSize;
+		numWay = 1;
+	}
+	return num_reject_reason;
+}
+
+/* Same as Mat::Initialize, with the subarray that it builds */
+RejectReason DesignFilter::CheckMat(int numRowSubarray, int numColumnSubarray, int numAddressBit, long numDataBit, int numWay,
+		int numActiveSubarrayPerRow, int numActiveSubarrayPerColumn, int muxSenseAmp,
+		int muxOutputLev1, int muxOutputLev2, MemoryType memoryType) const {
+	numActiveSubarrayPerRow = MIN(numActiveSubarrayPerRow, numColumnSubarray);
+	numActiveSubarrayPerColumn = MIN(numActiveSubarrayPerColumn, numRowSubarray);
+	numAddressBit -= (int)(log2(numRowSubarray * numColumnSubarray / numActiveSubarrayPerColumn / numActiveSubarrayPerRow)+0.1);
+	if (numAddressBit <= 0)
+		return reject_mat_address;
+
+	long long numRow = 1 << numAddressBit;
+	if (memoryType == MemoryType::data)
+		numRow *= numWay;
+	numRow /= (muxSenseAmp * muxOutputLev1 * muxOutputLev2);
+	if (numRow == 0)
+		return reject_subarray_row;
+
+	long long numColumn = (long long)numDataBit / (numActiveSubarrayPerRow * numActiveSubarrayPerColumn);
+	if (numColumn == 0)
+		return reject_subarray_column;
+	numColumn *= muxSenseAmp * muxOutputLev1 * muxOutputLev2;
+	if (memoryType == tag)
+		numColumn *= numWay;
+
+	RejectReason reason = CheckSubarray(numRow, numColumn, muxSenseAmp);
+	if (reason != num_reject_reason)
+		return reason;
+
+	if (numAddressBit - (int)(log2(muxSenseAmp * muxOutputLev1 * muxOutputLev2)+0.1) < 0)
+		return reject_row_predecoder;
+	return num_reject_reason;
+}
+
+/* Same as the legality checks at the beginning of SubArray::Initialize, with internal sensing */
+RejectReason DesignFilter::CheckSubarray(long long numRow, long long numColumn, int muxSenseAmp) const {
+	if (inputParameter->designTarget == cache && inputParameter->cacheAccessMode != sequential_access_mode) {
+		if (numColumn < inputParameter->associativity)
+			return reject_associativity;
+	}
+	if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+		if (muxSenseAmp > 1)
+			return reject_dram_mux;
+	}
+	if (cell->memCellType == SLCNAND) {
+		if (numRow < inputParameter->flashBlockSize / inputParameter->pageSize)
+			return reject_nand_page;
+		if (muxSenseAmp < 2)
+			return reject_sense_amp_mux;
+	}
+	if (cell->memCellType == memristor || cell->memCellType == FBRAM) {
+		if (muxSenseAmp < 2)
+			return reject_sense_amp_mux;
+	}
+	if (cell->memCellType == FBRAM) {
+		if (cell->resistanceOff / cell->resistanceOn < numRow / BITLINE_LEAKAGE_TOLERANCE)
+			return reject_bitline_leakage;
+	}
+	return num_reject_reason;
+}
+
+void DesignFilter::Merge(const DesignFilter &other) {
+	for (int i = 0; i < num_reject_reason; i++)
+		numRejected[i] += other.numRejected[i];
+}
+
+long long DesignFilter::TotalRejected() const {
+	long long total = 0;
+	for (int i = 0; i < num_reject_reason; i++)
+		total += numRejected[i];
+	return total;
+}
+
+void DesignFilter::PrintStatistics(ostream &output) const {
+	long long total = TotalRejected();
+	if (total == 0)
+		return;
+	output << "numRejected = " << total << " before evaluation (";
+	bool first = true;
+	for (int i = 0; i < num_reject_reason; i++) {
+		if (numRejected[i] == 0)
+			continue;
+		output << (first ? "" : ", ") << reasonNames[i] << ": " << numRejected[i];
+		first = false;
+	}
+	output << ")" << endl;
+}
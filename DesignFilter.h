@@ -0,0 +1,73 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef DESIGNFILTER_H_
+#define DESIGNFILTER_H_
+
+#include <ostream>
+#include "typedef.h"
+
+using namespace std;
+
+/* Why a design is known to be invalid before it is evaluated */
+enum RejectReason {
+	reject_htree_routing = 0,	/* The H-tree runs out of address or data bits before it reaches the mats */
+	reject_row_per_set,			/* A set can not be spread over numRowPerSet rows of a mat */
+	reject_tag_way,				/* A tag mat does not hold at least one way */
+	reject_mat_address,			/* Too aggressive partitioning, no address bit is left for the subarray rows */
+	reject_subarray_row,		/* No subarray row is left after the column muxes */
+	reject_subarray_column,		/* No subarray column is left */
+	reject_associativity,		/* A subarray has fewer columns than the ways of a set */
+	reject_dram_mux,			/* DRAM and eDRAM do not allow muxed bitlines */
+	reject_nand_page,			/* A SLC NAND subarray has fewer rows than the pages of a flash block */
+	reject_sense_amp_mux,		/* No room for the internal sense amp without a bitline mux */
+	reject_bitline_leakage,		/* The FBRAM bitline is too long for the off/on resistance ratio */
+	reject_row_predecoder,		/* Fewer address bits than the column mux levels decode */
+	num_reject_reason			/* Not rejected */
+};
+
+/* The checks of BankWithHtree, BankWithoutHtree, Mat and SubArray that only depend on the BIGFOR indices
+ * and the cell type, done in integers before any bank is built. A design is only rejected if its
+ * evaluation would find it invalid before its mat is used, so the rejected designs are exactly the ones
+ * that never reach the results, the output file or the search bound. The checks on the currents, the
+ * driver sizes and the latencies are still done by the evaluation */
+class DesignFilter {
+public:
+	DesignFilter();
+	virtual ~DesignFilter();
+
+	/* Functions */
+	void Initialize();	/* With the current input parameters */
+	bool Reject(int numRowMat, int numColumnMat, long long capacity, long blockSize, int associativity,
+			int numRowPerSet, int numActiveMatPerRow, int numActiveMatPerColumn, int muxSenseAmp,
+			int muxOutputLev1, int muxOutputLev2, int numRowSubarray, int numColumnSubarray,
+			int numActiveSubarrayPerRow, int numActiveSubarrayPerColumn, MemoryType memoryType,
+			int stackedDieCount);	/* Counts the design by its reason if it is rejected */
+	void Merge(const DesignFilter &other);
+	long long TotalRejected() const;
+	void PrintStatistics(ostream &output) const;	/* One line, nothing if no design is rejected */
+
+	/* Properties */
+	bool enabled;	/* Only internal sensing, the banks with external sensing print their own errors */
+	long long numRejected[num_reject_reason];
+
+private:
+	RejectReason CheckHtree(int numRowMat, int numColumnMat, long long capacity, long blockSize, int associativity,
+			int numRowPerSet, int numActiveMatPerRow, int numActiveMatPerColumn, int &muxSenseAmp,
+			int &muxOutputLev1, int &muxOutputLev2, MemoryType memoryType, int stackedDieCount,
+			int &numAddressBit, long &numDataBit, int &numWay) const;
+	RejectReason CheckWithoutHtree(int numRowMat, int numColumnMat, long long capacity, long blockSize, int associativity,
+			int numRowPerSet, int numActiveMatPerRow, int numActiveMatPerColumn, int &muxSenseAmp,
+			int &muxOutputLev1, int &muxOutputLev2, MemoryType memoryType, int stackedDieCount,
+			int &numAddressBit, long &numDataBit, int &numWay) const;
+	RejectReason CheckMat(int numRowSubarray, int numColumnSubarray, int numAddressBit, long numDataBit, int numWay,
+			int numActiveSubarrayPerRow, int numActiveSubarrayPerColumn, int muxSenseAmp,
+			int muxOutputLev1, int muxOutputLev2, MemoryType memoryType) const;
+	RejectReason CheckSubarray(long long numRow, long long numColumn, int muxSenseAmp) const;
+	void AddWayMux(int numWayPerRow, int &muxSenseAmp, int &muxOutputLev1, int &muxOutputLev2) const;
+};
+
+#endif /* DESIGNFILTER_H_ */
@@ -0,0 +1,165 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "DesignStore.h"
+#include <algorithm>
+
+DesignStore::DesignStore() {
+	// TODO Auto-generated constructor stub
+}
+
+DesignStore::~DesignStore() {
+	// TODO Auto-generated destructor stub
+}
+
+void DesignStore::Insert(const Bank &bank, const Wire &localWire, const Wire &globalWire, long long sequence) {
+	metrics[pareto_read_latency].push_back(bank.readLatency);
+	metrics[pareto_write_latency].push_back(bank.writeLatency);
+	metrics[pareto_read_dynamic_energy].push_back(bank.readDynamicEnergy);
+	metrics[pareto_write_dynamic_energy].push_back(bank.writeDynamicEnergy);
+	metrics[pareto_leakage].push_back(bank.leakage);
+	metrics[pareto_area].push_back(bank.area);
+	DesignPoint point;
+	point.Set(bank, localWire, globalWire);
+	points.push_back(point);
+	sequences.push_back(sequence);
+}
+
+void DesignStore::Merge(const DesignStore &other) {
+	for (int m = 0; m < num_pareto_metric; m++)
+		metrics[m].insert(metrics[m].end(), other.metrics[m].begin(), other.metrics[m].end());
+	points.insert(points.end(), other.points.begin(), other.points.end());
+	sequences.insert(sequences.end(), other.sequences.begin(), other.sequences.end());
+}
+
+void DesignStore::Sort() {
+	vector<int> order(points.size());
+	for (int i = 0; i < (int)order.size(); i++)
+		order[i] = i;
+	sort(order.begin(), order.end(), [this](int a, int b) {
+		return sequences[a] < sequences[b];
+	});
+
+	vector<double> sortedMetrics(order.size());
+	for (int m = 0; m < num_pareto_metric; m++) {
+		for (int i = 0; i < (int)order.size(); i++)
+			sortedMetrics[i] = metrics[m][order[i]];
+		metrics[m].swap(sortedMetrics);
+	}
+	vector<DesignPoint> sortedPoints(order.size());
+	vector<long long> sortedSequences(order.size());
+	for (int i = 0; i < (int)order.size(); i++) {
+		sortedPoints[i] = points[order[i]];
+		sortedSequences[i] = sequences[order[i]];
+	}
+	points.swap(sortedPoints);
+	sequences.swap(sortedSequences);
+}
+
+void DesignStore::Clear() {
+	for (int m = 0; m < num_pareto_metric; m++)
+		metrics[m].clear();
+	points.clear();
+	sequences.clear();
+}
+
+bool DesignStore::WithinLimits(const Result &result, int i) const {
+	/* Same tests as Result::compareAndUpdate */
+	double readLatency = metrics[pareto_read_latency][i];
+	double writeLatency = metrics[pareto_write_latency][i];
+	double readDynamicEnergy = metrics[pareto_read_dynamic_energy][i];
+	double writeDynamicEnergy = metrics[pareto_write_dynamic_energy][i];
+	return readLatency <= result.limitReadLatency && writeLatency <= result.limitWriteLatency
+			&& readDynamicEnergy <= result.limitReadDynamicEnergy && writeDynamicEnergy <= result.limitWriteDynamicEnergy
+			&& readLatency * readDynamicEnergy <= result.limitReadEdp
+			&& writeLatency * writeDynamicEnergy <= result.limitWriteEdp
+			&& metrics[pareto_area][i] <= result.limitArea && metrics[pareto_leakage][i] <= result.limitLeakage;
+}
+
+long long DesignStore::Count(const Result &result) const {
+	long long numWithinLimits = 0;
+	for (int i = 0; i < Size(); i++)
+		if (WithinLimits(result, i))
+			numWithinLimits++;
+	return numWithinLimits;
+}
+
+int DesignStore::FindBest(const Result &result) const {
+	const double *readLatency = metrics[pareto_read_latency].data();
+	const double *writeLatency = metrics[pareto_write_latency].data();
+	const double *readDynamicEnergy = metrics[pareto_read_dynamic_energy].data();
+	const double *writeDynamicEnergy = metrics[pareto_write_dynamic_energy].data();
+	const double *leakage = metrics[pareto_leakage].data();
+	const double *area = metrics[pareto_area].data();
+
+	/* Same comparison as Result::compareAndUpdate, starting from the current bank of result */
+	double bestMetric;
+	switch (result.optimizationTarget) {
+	case read_latency_optimized:
+		bestMetric = result.bank->readLatency;
+		break;
+	case write_latency_optimized:
+		bestMetric = result.bank->writeLatency;
+		break;
+	case read_energy_optimized:
+		bestMetric = result.bank->readDynamicEnergy;
+		break;
+	case write_energy_optimized:
+		bestMetric = result.bank->writeDynamicEnergy;
+		break;
+	case read_edp_optimized:
+		bestMetric = result.bank->readLatency * result.bank->readDynamicEnergy;
+		break;
+	case write_edp_optimized:
+		bestMetric = result.bank->writeLatency * result.bank->writeDynamicEnergy;
+		break;
+	case area_optimized:
+		bestMetric = result.bank->area;
+		break;
+	case leakage_optimized:
+		bestMetric = result.bank->leakage;
+		break;
+	default:	/* Exploration */
+		return -1;
+	}
+
+	int best = -1;
+	for (int i = 0; i < Size(); i++) {
+		if (!WithinLimits(result, i))
+			continue;
+		double metric;
+		switch (result.optimizationTarget) {
+		case read_latency_optimized:
+			metric = readLatency[i];
+			break;
+		case write_latency_optimized:
+			metric = writeLatency[i];
+			break;
+		case read_energy_optimized:
+			metric = readDynamicEnergy[i];
+			break;
+		case write_energy_optimized:
+			metric = writeDynamicEnergy[i];
+			break;
+		case read_edp_optimized:
+			metric = readLatency[i] * readDynamicEnergy[i];
+			break;
+		case write_edp_optimized:
+			metric = writeLatency[i] * writeDynamicEnergy[i];
+			break;
+		case area_optimized:
+			metric = area[i];
+			break;
+		default:	/* leakage */
+			metric = leakage[i];
+		}
+		if (metric < bestMetric) {
+			bestMetric = metric;
+			best = i;
+		}
+	}
+	return best;
+}
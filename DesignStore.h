@@ -0,0 +1,43 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef DESIGNSTORE_H_
+#define DESIGNSTORE_H_
+
+#include <vector>
+#include "ParetoArchive.h"
+#include "Result.h"
+
+using namespace std;
+
+/* The metrics of every valid design of a search, in the serial order of the search, with what is needed
+ * to calculate each design again. The metrics are stored one array per metric (see ParetoMetric), so that
+ * the best design under a set of limits is found without running the search again */
+class DesignStore {
+public:
+	DesignStore();
+	virtual ~DesignStore();
+
+	/* Functions */
+	void Insert(const Bank &bank, const Wire &localWire, const Wire &globalWire, long long sequence);
+	void Merge(const DesignStore &other);
+	void Sort();	/* Order by the sequence numbers, needed after Merge */
+	void Clear();
+	int FindBest(const Result &result) const;	/* The design that result ends up with if every design is offered to
+												 * result.compareAndUpdate in order, -1 if none of them is accepted */
+	long long Count(const Result &result) const;	/* Number of designs within the limits of result */
+	int Size() const { return (int)points.size(); }
+	const DesignPoint & Point(int i) const { return points[i]; }
+
+private:
+	bool WithinLimits(const Result &result, int i) const;
+
+	vector<double> metrics[num_pareto_metric];
+	vector<DesignPoint> points;
+	vector<long long> sequences;	/* Position of each design in the serial order of the search */
+};
+
+#endif /* DESIGNSTORE_H_ */
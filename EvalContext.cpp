@@ -0,0 +1,79 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "EvalContext.h"
+#include "global.h"
+
+EvalContext::EvalContext() {
+	inputParameter = NULL;
+	tech = NULL;
+	devtech = NULL;
+	cell = NULL;
+	localWire = NULL;
+	globalWire = NULL;
+}
+
+EvalContext::~EvalContext() {
+	// TODO Auto-generated destructor stub
+}
+
+void EvalContext::Capture() {
+	inputParameter = ::inputParameter;
+
+	privateTech = *(::tech);
+	tech = &privateTech;
+	if (::devtech == ::tech) {
+		/* In most cases device technology is the same as the peripheral technology */
+		devtech = &privateTech;
+	} else {
+		privateDevtech = *(::devtech);
+		devtech = &privateDevtech;
+	}
+
+	privateCell = *(::cell);
+	cell = &privateCell;
+
+	/* Wire::operator= does not copy the sense amplifier of low swing wires, so build the wires again */
+	privateLocalWire.Initialize(::localWire->featureSizeInNano, ::localWire->wireType, ::localWire->wireRepeaterType,
+			::localWire->temperature, ::localWire->isLowSwing);
+	localWire = &privateLocalWire;
+	privateGlobalWire.Initialize(::globalWire->featureSizeInNano, ::globalWire->wireType, ::globalWire->wireRepeaterType,
+			::globalWire->temperature, ::globalWire->isLowSwing);
+	globalWire = &privateGlobalWire;
+}
+
+void EvalContext::Bind() {
+	::inputParameter = inputParameter;
+	::tech = tech;
+	::devtech = devtech;
+	::cell = cell;
+	::localWire = localWire;
+	::globalWire = globalWire;
+}
+
+EvalContextScope::EvalContextScope(EvalContext *context) {
+	bound = (context != NULL && context->tech != tech);
+	if (bound) {
+		savedInputParameter = inputParameter;
+		savedTech = tech;
+		savedDevtech = devtech;
+		savedCell = cell;
+		savedLocalWire = localWire;
+		savedGlobalWire = globalWire;
+		context->Bind();
+	}
+}
+
+EvalContextScope::~EvalContextScope() {
+	if (bound) {
+		inputParameter = savedInputParameter;
+		tech = savedTech;
+		devtech = savedDevtech;
+		cell = savedCell;
+		localWire = savedLocalWire;
+		globalWire = savedGlobalWire;
+	}
+}
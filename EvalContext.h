@@ -0,0 +1,64 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef EVALCONTEXT_H_
+#define EVALCONTEXT_H_
+
+#include "InputParameter.h"
+#include "Technology.h"
+#include "MemCell.h"
+#include "Wire.h"
+
+/* The state that a design evaluation reads: input parameters, technology, memory cell and wires.
+ * A context owns private copies of everything that is modified during an evaluation, so that
+ * independent evaluations (for example the exploration threads) do not share any mutable state.
+ * The components keep reading the globals in global.h, which point to the context that is bound
+ * to the calling thread. */
+class EvalContext {
+public:
+	EvalContext();
+	virtual ~EvalContext();
+
+	/* Functions */
+	void Capture();		/* Make private copies of the state that is bound to the calling thread */
+	void Bind();		/* Bind this context to the calling thread */
+
+	/* Properties */
+	InputParameter *inputParameter;	/* Shared, only read during the evaluation */
+	Technology *tech;
+	Technology *devtech;
+	MemCell *cell;
+	Wire *localWire;
+	Wire *globalWire;
+
+private:
+	EvalContext(const EvalContext &);
+	EvalContext & operator=(const EvalContext &);
+
+	Technology privateTech;
+	Technology privateDevtech;
+	MemCell privateCell;
+	Wire privateLocalWire;
+	Wire privateGlobalWire;
+};
+
+/* Binds a context to the calling thread for the lifetime of the scope, a NULL context keeps the current one */
+class EvalContextScope {
+public:
+	EvalContextScope(EvalContext *context);
+	~EvalContextScope();
+
+private:
+	bool bound;
+	InputParameter *savedInputParameter;
+	Technology *savedTech;
+	Technology *savedDevtech;
+	MemCell *savedCell;
+	Wire *savedLocalWire;
+	Wire *savedGlobalWire;
+};
+
+#endif /* EVALCONTEXT_H_ */
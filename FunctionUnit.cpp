@@ -50,7 +50,7 @@ int FunctionUnit::logical_effort(
     double C_load,
     double p_to_n_sz_ratio,
     double max_w_nmos,
-    Technology tech)
+    const Technology &tech)
 {
   int num_gates = (int) (log(F) / log(fopt));
 
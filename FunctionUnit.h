@@ -39,7 +39,7 @@ public:
 
     int logical_effort(int num_gates_min, double g, double F, double *w_n, double *w_p,
                        double C_load, double p_to_n_sz_ratio, double max_w_nmos,
-                       Technology tech);
+                       const Technology &tech);
 };
 
 #endif /* FUNCTIONUNIT_H_ */
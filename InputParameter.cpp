@@ -102,6 +102,14 @@ InputParameter::InputParameter() {
     allowDifferentTagTech = false;
 
     printLevel = 1;
+
+    numThreads = 1;
+    numCellThreads = 1;
+    branchAndBound = false;
+    profileFormat = no_profile;
+    outputFormat = csv_format;
+    backgroundWriter = false;
+    concurrentTagSearch = false;
 }
 
 InputParameter::~InputParameter() {
@@ -156,6 +164,8 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 				optimizationTarget = leakage_optimized;
 			else if (!strcmp(tmp, "Area"))
 				optimizationTarget = area_optimized;
+			else if (!strcmp(tmp, "Pareto"))
+				optimizationTarget = pareto_exploration;
 			else
 				optimizationTarget = full_exploration;
 			continue;
@@ -650,12 +660,171 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 
         if (!strncmp("-PrintLevel", line, strlen("-PrintLevel"))) {
             sscanf(line, "-PrintLevel: %d", &printLevel);
+            continue;
+        }
+
+        if (!strncmp("-Threads", line, strlen("-Threads"))) {
+            sscanf(line, "-Threads: %d", &numThreads);
+            if (numThreads < 1)
+                numThreads = 1;
+            continue;
+        }
+
+        if (!strncmp("-CellThreads", line, strlen("-CellThreads"))) {
+            sscanf(line, "-CellThreads: %d", &numCellThreads);
+            if (numCellThreads < 1)
+                numCellThreads = 1;
+            continue;
+        }
+
+        if (!strncmp("-Profile", line, strlen("-Profile"))) {
+            sscanf(line, "-Profile: %s", tmp);
+            if (!strcmp(tmp, "table"))
+                profileFormat = table_profile;
+            else if (!strcmp(tmp, "json"))
+                profileFormat = json_profile;
+            else
+                profileFormat = no_profile;
+            continue;
+        }
+
+        if (!strncmp("-OutputFormat", line, strlen("-OutputFormat"))) {
+            sscanf(line, "-OutputFormat: %s", tmp);
+            if (!strcmp(tmp, "binary"))
+                outputFormat = binary_format;
+            else
+                outputFormat = csv_format;
+            continue;
+        }
+
+        if (!strncmp("-BackgroundWriter", line, strlen("-BackgroundWriter"))) {
+            sscanf(line, "-BackgroundWriter: %s", tmp);
+            if (!strcmp(tmp, "true"))
+                backgroundWriter = true;
+            else
+                backgroundWriter = false;
+            continue;
+        }
+
+        if (!strncmp("-ConcurrentTagSearch", line, strlen("-ConcurrentTagSearch"))) {
+            sscanf(line, "-ConcurrentTagSearch: %s", tmp);
+            if (!strcmp(tmp, "true"))
+                concurrentTagSearch = true;
+            else
+                concurrentTagSearch = false;
+            continue;
+        }
+
+        if (!strncmp("-BranchAndBound", line, strlen("-BranchAndBound"))) {
+            sscanf(line, "-BranchAndBound: %s", tmp);
+            if (!strcmp(tmp, "true"))
+                branchAndBound = true;
+            else
+                branchAndBound = false;
+            continue;
         }
 	}
 
 	fclose(fp);
 }
 
+SearchBounds InputParameter::SaveSearchBounds() const {
+	SearchBounds bounds;
+	bounds.minNumRowMat = minNumRowMat;
+	bounds.maxNumRowMat = maxNumRowMat;
+	bounds.minNumColumnMat = minNumColumnMat;
+	bounds.maxNumColumnMat = maxNumColumnMat;
+	bounds.minNumActiveMatPerRow = minNumActiveMatPerRow;
+	bounds.maxNumActiveMatPerRow = maxNumActiveMatPerRow;
+	bounds.minNumActiveMatPerColumn = minNumActiveMatPerColumn;
+	bounds.maxNumActiveMatPerColumn = maxNumActiveMatPerColumn;
+	bounds.minNumRowSubarray = minNumRowSubarray;
+	bounds.maxNumRowSubarray = maxNumRowSubarray;
+	bounds.minNumColumnSubarray = minNumColumnSubarray;
+	bounds.maxNumColumnSubarray = maxNumColumnSubarray;
+	bounds.minNumActiveSubarrayPerRow = minNumActiveSubarrayPerRow;
+	bounds.maxNumActiveSubarrayPerRow = maxNumActiveSubarrayPerRow;
+	bounds.minNumActiveSubarrayPerColumn = minNumActiveSubarrayPerColumn;
+	bounds.maxNumActiveSubarrayPerColumn = maxNumActiveSubarrayPerColumn;
+	bounds.minMuxSenseAmp = minMuxSenseAmp;
+	bounds.maxMuxSenseAmp = maxMuxSenseAmp;
+	bounds.minMuxOutputLev1 = minMuxOutputLev1;
+	bounds.maxMuxOutputLev1 = maxMuxOutputLev1;
+	bounds.minMuxOutputLev2 = minMuxOutputLev2;
+	bounds.maxMuxOutputLev2 = maxMuxOutputLev2;
+	bounds.minNumRowPerSet = minNumRowPerSet;
+	bounds.maxNumRowPerSet = maxNumRowPerSet;
+	bounds.minAreaOptimizationLevel = minAreaOptimizationLevel;
+	bounds.maxAreaOptimizationLevel = maxAreaOptimizationLevel;
+	bounds.minLocalWireType = minLocalWireType;
+	bounds.maxLocalWireType = maxLocalWireType;
+	bounds.minGlobalWireType = minGlobalWireType;
+	bounds.maxGlobalWireType = maxGlobalWireType;
+	bounds.minLocalWireRepeaterType = minLocalWireRepeaterType;
+	bounds.maxLocalWireRepeaterType = maxLocalWireRepeaterType;
+	bounds.minGlobalWireRepeaterType = minGlobalWireRepeaterType;
+	bounds.maxGlobalWireRepeaterType = maxGlobalWireRepeaterType;
+	bounds.minIsLocalWireLowSwing = minIsLocalWireLowSwing;
+	bounds.maxIsLocalWireLowSwing = maxIsLocalWireLowSwing;
+	bounds.minIsGlobalWireLowSwing = minIsGlobalWireLowSwing;
+	bounds.maxIsGlobalWireLowSwing = maxIsGlobalWireLowSwing;
+	bounds.minStackLayer = minStackLayer;
+	bounds.maxStackLayer = maxStackLayer;
+	return bounds;
+}
+
+void InputParameter::RestoreSearchBounds(const SearchBounds &bounds) {
+	minNumRowMat = bounds.minNumRowMat;
+	maxNumRowMat = bounds.maxNumRowMat;
+	minNumColumnMat = bounds.minNumColumnMat;
+	maxNumColumnMat = bounds.maxNumColumnMat;
+	minNumActiveMatPerRow = bounds.minNumActiveMatPerRow;
+	maxNumActiveMatPerRow = bounds.maxNumActiveMatPerRow;
+	minNumActiveMatPerColumn = bounds.minNumActiveMatPerColumn;
+	maxNumActiveMatPerColumn = bounds.maxNumActiveMatPerColumn;
+	minNumRowSubarray = bounds.minNumRowSubarray;
+	maxNumRowSubarray = bounds.maxNumRowSubarray;
+	minNumColumnSubarray = bounds.minNumColumnSubarray;
+	maxNumColumnSubarray = bounds.maxNumColumnSubarray;
+	minNumActiveSubarrayPerRow = bounds.minNumActiveSubarrayPerRow;
+	maxNumActiveSubarrayPerRow = bounds.maxNumActiveSubarrayPerRow;
+	minNumActiveSubarrayPerColumn = bounds.minNumActiveSubarrayPerColumn;
+	maxNumActiveSubarrayPerColumn = bounds.maxNumActiveSubarrayPerColumn;
+	minMuxSenseAmp = bounds.minMuxSenseAmp;
+	maxMuxSenseAmp = bounds.maxMuxSenseAmp;
+	minMuxOutputLev1 = bounds.minMuxOutputLev1;
+	maxMuxOutputLev1 = bounds.maxMuxOutputLev1;
+	minMuxOutputLev2 = bounds.minMuxOutputLev2;
+	maxMuxOutputLev2 = bounds.maxMuxOutputLev2;
+	minNumRowPerSet = bounds.minNumRowPerSet;
+	maxNumRowPerSet = bounds.maxNumRowPerSet;
+	minAreaOptimizationLevel = bounds.minAreaOptimizationLevel;
+	maxAreaOptimizationLevel = bounds.maxAreaOptimizationLevel;
+	minLocalWireType = bounds.minLocalWireType;
+	maxLocalWireType = bounds.maxLocalWireType;
+	minGlobalWireType = bounds.minGlobalWireType;
+	maxGlobalWireType = bounds.maxGlobalWireType;
+	minLocalWireRepeaterType = bounds.minLocalWireRepeaterType;
+	maxLocalWireRepeaterType = bounds.maxLocalWireRepeaterType;
+	minGlobalWireRepeaterType = bounds.minGlobalWireRepeaterType;
+	maxGlobalWireRepeaterType = bounds.maxGlobalWireRepeaterType;
+	minIsLocalWireLowSwing = bounds.minIsLocalWireLowSwing;
+	maxIsLocalWireLowSwing = bounds.maxIsLocalWireLowSwing;
+	minIsGlobalWireLowSwing = bounds.minIsGlobalWireLowSwing;
+	maxIsGlobalWireLowSwing = bounds.maxIsGlobalWireLowSwing;
+	minStackLayer = bounds.minStackLayer;
+	maxStackLayer = bounds.maxStackLayer;
+}
+
+SearchBoundsScope::SearchBoundsScope(InputParameter *_parameter) {
+	parameter = _parameter;
+	savedBounds = parameter->SaveSearchBounds();
+}
+
+SearchBoundsScope::~SearchBoundsScope() {
+	parameter->RestoreSearchBounds(savedBounds);
+}
+
 void InputParameter::PrintInputParameter() {
 	cout << endl << "====================" << endl << "DESIGN SPECIFICATION" << endl << "====================" << endl;
 	cout << "Design Target: ";
@@ -697,6 +866,8 @@ void InputParameter::PrintInputParameter() {
 	if (optimizationTarget == full_exploration) {
 		cout << endl << "Full design space exploration ... might take hours and will produce a csv" << endl;
 		cout << "If you are interested in optimizing for a single metric only, please change -OptimizationTarget in *cfg file, for example \n -OptimizationTarget: WriteEDP" << endl;
+	} else if (optimizationTarget == pareto_exploration) {
+		cout << endl << "Searching for the Pareto frontier of read/write latency, read/write energy, leakage and area ... will produce a csv" << endl;
 	} else {
 		cout << endl << "Searching for the best solution that is optimized for ";
 		switch (optimizationTarget) {
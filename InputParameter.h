@@ -18,6 +18,50 @@
 
 using namespace std;
 
+/* A value copy of the search bounds of InputParameter, the bounds that the passes of nvsim() narrow down */
+struct SearchBounds {
+	int minNumRowMat;
+	int maxNumRowMat;
+	int minNumColumnMat;
+	int maxNumColumnMat;
+	int minNumActiveMatPerRow;
+	int maxNumActiveMatPerRow;
+	int minNumActiveMatPerColumn;
+	int maxNumActiveMatPerColumn;
+	int minNumRowSubarray;
+	int maxNumRowSubarray;
+	int minNumColumnSubarray;
+	int maxNumColumnSubarray;
+	int minNumActiveSubarrayPerRow;
+	int maxNumActiveSubarrayPerRow;
+	int minNumActiveSubarrayPerColumn;
+	int maxNumActiveSubarrayPerColumn;
+	int minMuxSenseAmp;
+	int maxMuxSenseAmp;
+	int minMuxOutputLev1;
+	int maxMuxOutputLev1;
+	int minMuxOutputLev2;
+	int maxMuxOutputLev2;
+	int minNumRowPerSet;
+	int maxNumRowPerSet;
+	int minAreaOptimizationLevel;
+	int maxAreaOptimizationLevel;
+	int minLocalWireType;
+	int maxLocalWireType;
+	int minGlobalWireType;
+	int maxGlobalWireType;
+	int minLocalWireRepeaterType;
+	int maxLocalWireRepeaterType;
+	int minGlobalWireRepeaterType;
+	int maxGlobalWireRepeaterType;
+	int minIsLocalWireLowSwing;
+	int maxIsLocalWireLowSwing;
+	int minIsGlobalWireLowSwing;
+	int maxIsGlobalWireLowSwing;
+	int minStackLayer;
+	int maxStackLayer;
+};
+
 class InputParameter {
 public:
 	InputParameter();
@@ -26,6 +70,8 @@ public:
 	/* Functions */
 	void ReadInputParameterFromFile(const std::string & inputFile);
 	void PrintInputParameter();
+	SearchBounds SaveSearchBounds() const;
+	void RestoreSearchBounds(const SearchBounds &bounds);
 
 	/* Properties */
 	DesignTarget designTarget;		/* Cache, RAM, or CAM */
@@ -118,6 +164,25 @@ public:
     bool allowDifferentTagTech;
 
     int printLevel;
+
+    int numThreads;	/* Number of threads that explore the design space */
+    int numCellThreads;	/* Number of memory cell types that are explored at the same time */
+    ProfileFormat profileFormat;	/* Whether the time of the exploration phases and the components is reported */
+    OutputFormat outputFormat;	/* Format of the output file of the full and the Pareto exploration */
+    bool backgroundWriter;	/* Whether the output file is written on its own thread */
+    bool concurrentTagSearch;	/* Whether the cache tag array is searched on its own thread while the data array is searched */
+    bool branchAndBound;	/* Whether to skip the designs that can not beat the best one, single optimization target only */
+};
+
+/* Restores the search bounds that an InputParameter has when the scope starts, when the scope ends */
+class SearchBoundsScope {
+public:
+	SearchBoundsScope(InputParameter *_parameter);
+	virtual ~SearchBoundsScope();
+
+private:
+	InputParameter *parameter;
+	SearchBounds savedBounds;
 };
 
 #endif /* INPUTPARAMETER_H_ */
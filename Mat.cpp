@@ -9,11 +9,18 @@
 #include "Mat.h"
 #include "formula.h"
 #include "global.h"
+#include "EvalContext.h"
+#include "Profiler.h"
 
 Mat::Mat() {
 	// TODO Auto-generated constructor stub
 	initialized = false;
 	invalid = false;
+	context = NULL;
+	subarrayRampInput = 0;
+	subarrayCalculated = false;
+	matRampInput = 0;
+	matCalculated = false;
 }
 
 Mat::~Mat() {
@@ -24,7 +31,10 @@ void Mat::Initialize(int _numRowSubarray, int _numColumnSubarray, int _numAddres
 		int _numWay, int _numRowPerSet, bool _split, int _numActiveSubarrayPerRow, int _numActiveSubarrayPerColumn,
 		int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
 		BufferDesignTarget _areaOptimizationLevel, MemoryType _memoryType, int _stackedDieCount,
-        int _partitionGranularity, int monolithicStackCount) {
+        int _partitionGranularity, int monolithicStackCount, EvalContext *_context) {
+	PROFILE(profile_mat_initialize);
+	context = _context;
+	EvalContextScope scope(context);
 	if (initialized)
 		cout << "[Mat] Warning: Already initialized!" << endl;
 
@@ -59,6 +69,13 @@ void Mat::Initialize(int _numRowSubarray, int _numColumnSubarray, int _numAddres
 	muxOutputLev1 = _muxOutputLev1;
 	muxOutputLev2 = _muxOutputLev2;
 
+	matKey = MatCache::MakeKey(_numRowSubarray, _numColumnSubarray, _numAddressBit, _numDataBit,
+			_numWay, _numRowPerSet, _split, _numActiveSubarrayPerRow, _numActiveSubarrayPerColumn,
+			_muxSenseAmp, _internalSenseAmp, _muxOutputLev1, _muxOutputLev2,
+			_areaOptimizationLevel, _memoryType, _stackedDieCount, _partitionGranularity, monolithicStackCount);
+	matRampInput = -1;	/* the mat latency is not calculated yet */
+	matCalculated = false;
+
 	long long numRow = 0;		/* Number of rows in a subarray */
 	long long numColumn = 0;	/* Number of columns in a subarray */
 
@@ -94,15 +111,21 @@ void Mat::Initialize(int _numRowSubarray, int _numColumnSubarray, int _numAddres
 	if (memoryType == tag)
 		numColumn *= numWay;
 
-	subarray.Initialize(numRow, numColumn, numRowPerSet > 1, true /* TO-DO: need to correct */,
+	SubArrayCache &subarrayCache = SubArrayCache::ThreadCache();
+	subarrayKey = SubArrayCache::MakeKey(numRow, numColumn, numRowPerSet > 1, true /* TO-DO: need to correct */,
 			muxSenseAmp, internalSenseAmp, muxOutputLev1, muxOutputLev2, areaOptimizationLevel, monolithicStackCount);
+	subarrayRampInput = -1;	/* the subarray latency is not calculated yet */
+	subarrayCalculated = false;
+	if (!subarrayCache.LoadInitialized(subarrayKey, subarray)) {
+		InitializeSubarray();
+		subarrayCache.StoreInitialized(subarrayKey, subarray);
+	}
 
 	if (subarray.invalid) {
 		invalid = true;
 		initialized = true;
 		return;
 	}
-	subarray.CalculateArea();	/* the area needs to be calculated during the initialization because the size dimension needs to be called by others */
 
 	int numAddressRowPredecoderBlock1 = _numAddressBit - (int)(log2(muxSenseAmp * muxOutputLev1 * muxOutputLev2)+0.1);	/* The address bit on row decodeing */
 	if (numAddressRowPredecoderBlock1 < 0) {
@@ -169,13 +192,15 @@ void Mat::Initialize(int _numRowSubarray, int _numColumnSubarray, int _numAddres
     /* Initialize TSV connections. */
     if (stackedDieCount > 1 && partitionGranularity != 0) {
         TSV_type tsv_type = tech->WireTypeToTSVType(inputParameter->maxLocalWireType);
-        tsvArray.Initialize(tsv_type);
+        tsvArray.Initialize(tsv_type, stackedDieCount);
     }
 
 	initialized = true;
 }
 
 void Mat::CalculateArea() {
+	PROFILE(profile_mat_area);
+	EvalContextScope scope(context);
 	if (!initialized) {
 		cout << "[Mat] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -237,6 +262,8 @@ void Mat::CalculateArea() {
 }
 
 void Mat::CalculateRC() {
+	PROFILE(profile_mat_rc);
+	EvalContextScope scope(context);
 	if (!initialized) {
 		cout << "[Mat] Error: Require initialization first!" << endl;
 	} else if (!invalid){
@@ -256,11 +283,18 @@ void Mat::CalculateRC() {
 }
 
 void Mat::CalculateLatency(double _rampInput) {
+	PROFILE(profile_mat_latency);
+	EvalContextScope scope(context);
 	if (!initialized) {
 		cout << "[Mat] Error: Require initialization first!" << endl;
 	} else if (invalid) {
 		readLatency = writeLatency = invalid_value;
+	} else if (MatCache::ThreadCache().Load(matKey, _rampInput, *this)) {
+		/* The latency and the power are loaded from the mat cache */
+		matRampInput = _rampInput;
+		matCalculated = true;
 	} else {
+		matRampInput = _rampInput;
 		/* Calculate the predecoder blocks latency */
 		rowPredecoderBlock1.CalculateLatency(_rampInput);
 		rowPredecoderBlock2.CalculateLatency(_rampInput);
@@ -302,7 +336,13 @@ void Mat::CalculateLatency(double _rampInput) {
         }
 
 		/* Caluclate subarray latency */
-		subarray.CalculateLatency(MIN(rowPredecoderBlock1.rampOutput, rowPredecoderBlock2.rampOutput));
+		subarrayRampInput = MIN(rowPredecoderBlock1.rampOutput, rowPredecoderBlock2.rampOutput);
+		subarrayCalculated = SubArrayCache::ThreadCache().LoadCalculated(subarrayKey, subarrayRampInput, subarray);
+		if (!subarrayCalculated) {
+			if (!subarray.initialized)	/* only the area of the subarray is loaded from the subarray cache */
+				InitializeSubarray();
+			subarray.CalculateLatency(subarrayRampInput);
+		}
 
 		/* Add them together */
 		readLatency = predecoderLatency + subarray.readLatency;
@@ -322,11 +362,13 @@ void Mat::CalculateLatency(double _rampInput) {
 }
 
 void Mat::CalculatePower() {
+	PROFILE(profile_mat_power);
+	EvalContextScope scope(context);
 	if (!initialized) {
 		cout << "[Mat] Error: Require initialization first!" << endl;
 	} else if (invalid) {
 		readDynamicEnergy = writeDynamicEnergy = leakage = invalid_value;
-	} else {
+	} else if (!matCalculated) {
 		rowPredecoderBlock1.CalculatePower();
 		rowPredecoderBlock2.CalculatePower();
 		bitlineMuxPredecoderBlock1.CalculatePower();
@@ -335,7 +377,13 @@ void Mat::CalculatePower() {
 		senseAmpMuxLev1PredecoderBlock2.CalculatePower();
 		senseAmpMuxLev2PredecoderBlock1.CalculatePower();
 		senseAmpMuxLev2PredecoderBlock2.CalculatePower();
-		subarray.CalculatePower();
+		if (!subarrayCalculated) {
+			subarray.CalculatePower();
+			if (subarrayRampInput >= 0) {
+				SubArrayCache::ThreadCache().StoreCalculated(subarrayKey, subarrayRampInput, subarray);
+				subarrayCalculated = true;
+			}
+		}
 
 		readDynamicEnergy = rowPredecoderBlock1.readDynamicEnergy + rowPredecoderBlock2.readDynamicEnergy
 				+ bitlineMuxPredecoderBlock1.readDynamicEnergy + bitlineMuxPredecoderBlock2.readDynamicEnergy
@@ -384,9 +432,21 @@ void Mat::CalculatePower() {
 			leakage += comparator.leakage * numWay;
 		}
 
+		if (matRampInput >= 0) {
+			MatCache::ThreadCache().Store(matKey, matRampInput, *this);
+			matCalculated = true;
+		}
 	}
 }
 
+void Mat::InitializeSubarray() {
+	subarray.Initialize(subarrayKey.numRow, subarrayKey.numColumn, subarrayKey.multipleRowPerSet, subarrayKey.split,
+			subarrayKey.muxSenseAmp, subarrayKey.internalSenseAmp, subarrayKey.muxOutputLev1, subarrayKey.muxOutputLev2,
+			subarrayKey.areaOptimizationLevel, subarrayKey.num3DLevels, context);
+	if (!subarray.invalid)
+		subarray.CalculateArea();	/* the area needs to be calculated during the initialization because the size dimension needs to be called by others */
+}
+
 void Mat::PrintProperty() {
 	cout << "Mat Properties:" << endl;
 	FunctionUnit::PrintProperty();
@@ -428,6 +488,9 @@ Mat & Mat::operator=(const Mat &rhs) {
 	muxOutputLev2 = rhs.muxOutputLev2;
 	areaOptimizationLevel = rhs.areaOptimizationLevel;
 	memoryType = rhs.memoryType;
+	stackedDieCount = rhs.stackedDieCount;
+	partitionGranularity = rhs.partitionGranularity;
+	totalPredecoderOutputBits = rhs.totalPredecoderOutputBits;
 	predecoderLatency = rhs.predecoderLatency;
     areaAllLogicBlocks = rhs.areaAllLogicBlocks;
 
@@ -445,5 +508,9 @@ Mat & Mat::operator=(const Mat &rhs) {
 
     tsvArray = rhs.tsvArray;
 
+	subarrayKey = rhs.subarrayKey;
+	subarrayRampInput = rhs.subarrayRampInput;
+	subarrayCalculated = rhs.subarrayCalculated;
+
 	return *this;
 }
@@ -15,6 +15,8 @@
 #include "typedef.h"
 #include "Comparator.h"
 #include "TSV.h"
+#include "SubArrayCache.h"
+#include "MatCache.h"
 
 class Mat: public FunctionUnit {
 public:
@@ -27,7 +29,7 @@ public:
 			int _numWay, int _numRowPerSet, bool _split, int _numActiveSubarrayPerRow, int _numActiveSubarrayPerColumn,
 			int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
 			BufferDesignTarget _areaOptimizationLevel, MemoryType _memoryType, int _stackedDieCount,
-            int _partitionGranularity, int monolithicStackCount);
+            int _partitionGranularity, int monolithicStackCount, EvalContext *_context = NULL);
 	void CalculateArea();
 	void CalculateRC();
 	void CalculateLatency(double _rampInput);
@@ -73,6 +75,18 @@ public:
 	Comparator comparator;
 
     TSV tsvArray;
+
+	EvalContext *context;	/* The evaluation state, NULL if the state bound to the calling thread is used */
+
+private:
+	void InitializeSubarray();	/* Initializes the subarray of subarrayKey and calculates its area */
+
+	MatKey matKey;				/* Identifies the mat in the mat cache */
+	double matRampInput;		/* Input ramp of the mat, negative if its latency is not calculated, Unit: V/s */
+	bool matCalculated;			/* Whether the mat latency and power are loaded from the mat cache */
+	SubArrayKey subarrayKey;	/* Identifies the subarray in the subarray cache */
+	double subarrayRampInput;	/* Input ramp of the subarray, negative if its latency is not calculated, Unit: V/s */
+	bool subarrayCalculated;	/* Whether the subarray latency and power are loaded from the subarray cache */
 };
 
 #endif /* MAT_H_ */
@@ -0,0 +1,170 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "MatCache.h"
+#include "Mat.h"
+#include "formula.h"
+#include "global.h"
+#include <iostream>
+#include <functional>
+#include <atomic>
+
+/* Bound on the memory of each cache, a full cache is emptied, Unit: byte */
+#define MAX_MAT_CACHE_BYTE	(16 << 20)
+
+/* Memory of a map entry: the key, the value, the node link, the cached hash, the bucket and the heap header */
+#define MAT_ENTRY_BYTE	(sizeof(MatKey) + sizeof(MatResult) + 4 * sizeof(void *))
+
+/* Hits and misses of the threads that have finished, and the largest memory of their caches */
+static atomic<long long> totalHit(0);
+static atomic<long long> totalMiss(0);
+static atomic<long long> maxPeakByte(0);
+
+/* Raises peak to value */
+static void UpdatePeak(atomic<long long> &peak, long long value) {
+	long long current = peak;
+	while (value > current && !peak.compare_exchange_weak(current, value));
+}
+
+bool MatKey::operator==(const MatKey &rhs) const {
+	return numRowSubarray == rhs.numRowSubarray && numColumnSubarray == rhs.numColumnSubarray
+			&& numAddressBit == rhs.numAddressBit && numDataBit == rhs.numDataBit
+			&& numWay == rhs.numWay && numRowPerSet == rhs.numRowPerSet && split == rhs.split
+			&& numActiveSubarrayPerRow == rhs.numActiveSubarrayPerRow
+			&& numActiveSubarrayPerColumn == rhs.numActiveSubarrayPerColumn
+			&& muxSenseAmp == rhs.muxSenseAmp && internalSenseAmp == rhs.internalSenseAmp
+			&& muxOutputLev1 == rhs.muxOutputLev1 && muxOutputLev2 == rhs.muxOutputLev2
+			&& areaOptimizationLevel == rhs.areaOptimizationLevel && memoryType == rhs.memoryType
+			&& stackedDieCount == rhs.stackedDieCount && partitionGranularity == rhs.partitionGranularity
+			&& monolithicStackCount == rhs.monolithicStackCount
+			&& tech == rhs.tech && devtech == rhs.devtech && cell == rhs.cell && localWire == rhs.localWire
+			&& localWireType == rhs.localWireType && localWireRepeaterType == rhs.localWireRepeaterType
+			&& isLocalWireLowSwing == rhs.isLocalWireLowSwing && rampInput == rhs.rampInput;
+}
+
+size_t MatKeyHash::operator()(const MatKey &key) const {
+	size_t seed = 0;
+	size_t values[] = {
+			hash<int>()(key.numRowSubarray), hash<int>()(key.numColumnSubarray),
+			hash<int>()(key.numAddressBit), hash<long>()(key.numDataBit),
+			hash<int>()(key.numWay), hash<int>()(key.numRowPerSet),
+			hash<int>()(key.split + 2 * key.internalSenseAmp + 4 * key.isLocalWireLowSwing),
+			hash<int>()(key.numActiveSubarrayPerRow), hash<int>()(key.numActiveSubarrayPerColumn),
+			hash<int>()(key.muxSenseAmp), hash<int>()(key.muxOutputLev1), hash<int>()(key.muxOutputLev2),
+			hash<int>()(key.areaOptimizationLevel), hash<int>()(key.memoryType),
+			hash<int>()(key.stackedDieCount), hash<int>()(key.partitionGranularity),
+			hash<int>()(key.monolithicStackCount),
+			hash<const void *>()(key.tech), hash<const void *>()(key.devtech),
+			hash<const void *>()(key.cell), hash<const void *>()(key.localWire),
+			hash<int>()(key.localWireType), hash<int>()(key.localWireRepeaterType),
+			hash<double>()(key.rampInput)
+	};
+	for (int i = 0; i < (int)(sizeof(values) / sizeof(values[0])); i++)
+		seed ^= values[i] + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	return seed;
+}
+
+void MatResult::Save(const Mat &_mat) {
+	mat = _mat;
+	predecoderLatency = _mat.predecoderLatency;
+	subarray.Save(_mat.subarray);
+	comparator = _mat.comparator;
+	tsvArray = _mat.tsvArray;
+}
+
+void MatResult::Restore(Mat &_mat) const {
+	/* Only the FunctionUnit part of the mat and of its sub-components is assigned */
+	(FunctionUnit &)_mat = mat;
+	_mat.predecoderLatency = predecoderLatency;
+	subarray.Restore(_mat.subarray);
+	if (_mat.memoryType == tag && _mat.internalSenseAmp)
+		(FunctionUnit &)_mat.comparator = comparator;
+	(FunctionUnit &)_mat.tsvArray = tsvArray;
+}
+
+MatCache::MatCache() {
+	numHit = numMiss = 0;
+	peakByte = 0;
+}
+
+MatCache::~MatCache() {
+	totalHit += numHit;
+	totalMiss += numMiss;
+	UpdatePeak(maxPeakByte, peakByte);
+}
+
+MatCache & MatCache::ThreadCache() {
+	static thread_local MatCache cache;
+	return cache;
+}
+
+MatKey MatCache::MakeKey(int _numRowSubarray, int _numColumnSubarray, int _numAddressBit, long _numDataBit,
+		int _numWay, int _numRowPerSet, bool _split, int _numActiveSubarrayPerRow, int _numActiveSubarrayPerColumn,
+		int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
+		BufferDesignTarget _areaOptimizationLevel, MemoryType _memoryType, int _stackedDieCount,
+		int _partitionGranularity, int _monolithicStackCount) {
+	MatKey key;
+	key.numRowSubarray = _numRowSubarray;
+	key.numColumnSubarray = _numColumnSubarray;
+	key.numAddressBit = _numAddressBit;
+	key.numDataBit = _numDataBit;
+	key.numWay = _numWay;
+	key.numRowPerSet = _numRowPerSet;
+	key.split = _split;
+	key.numActiveSubarrayPerRow = _numActiveSubarrayPerRow;
+	key.numActiveSubarrayPerColumn = _numActiveSubarrayPerColumn;
+	key.muxSenseAmp = _muxSenseAmp;
+	key.internalSenseAmp = _internalSenseAmp;
+	key.muxOutputLev1 = _muxOutputLev1;
+	key.muxOutputLev2 = _muxOutputLev2;
+	key.areaOptimizationLevel = _areaOptimizationLevel;
+	key.memoryType = _memoryType;
+	key.stackedDieCount = _stackedDieCount;
+	key.partitionGranularity = _partitionGranularity;
+	key.monolithicStackCount = _monolithicStackCount;
+	key.tech = tech;
+	key.devtech = devtech;
+	key.cell = cell;
+	key.localWire = localWire;
+	key.localWireType = localWire->wireType;
+	key.localWireRepeaterType = localWire->wireRepeaterType;
+	key.isLocalWireLowSwing = localWire->isLowSwing;
+	key.rampInput = 0;
+	return key;
+}
+
+bool MatCache::Load(const MatKey &key, double rampInput, Mat &mat) {
+	MatKey calculatedKey = key;
+	calculatedKey.rampInput = rampInput;
+	unordered_map<MatKey, MatResult, MatKeyHash>::const_iterator it = entries.find(calculatedKey);
+	if (it == entries.end()) {
+		numMiss++;
+		return false;
+	}
+	numHit++;
+	it->second.Restore(mat);
+	return true;
+}
+
+void MatCache::Store(const MatKey &key, double rampInput, const Mat &mat) {
+	MatKey calculatedKey = key;
+	calculatedKey.rampInput = rampInput;
+	if ((entries.size() + 1) * MAT_ENTRY_BYTE > MAX_MAT_CACHE_BYTE)
+		entries.clear();
+	entries[calculatedKey].Save(mat);
+	peakByte = MAX(peakByte, (long long)(entries.size() * MAT_ENTRY_BYTE));
+}
+
+void MatCache::PrintStatistics() {
+	MatCache &cache = ThreadCache();
+	long long hit = totalHit + cache.numHit;
+	long long miss = totalMiss + cache.numMiss;
+	long long peakByte = MAX(maxPeakByte.load(), cache.peakByte);
+	cout << "Mat cache (latency/power)      : " << hit << " hits, " << miss << " misses";
+	if (hit + miss > 0)
+		cout << " (" << 100.0 * hit / (hit + miss) << "% hit rate)";
+	cout << ", " << peakByte / 1024 << " KB per thread" << endl;
+}
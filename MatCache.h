@@ -0,0 +1,98 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef MATCACHE_H_
+#define MATCACHE_H_
+
+#include <unordered_map>
+#include "SubArrayCache.h"
+#include "typedef.h"
+
+using namespace std;
+
+class Mat;
+
+/* Everything that a mat evaluation depends on: the Mat::Initialize parameters, the objects bound
+ * to the calling thread and the TSV state of the technology, which follows the layer count */
+struct MatKey {
+	int numRowSubarray;
+	int numColumnSubarray;
+	int numAddressBit;
+	long numDataBit;
+	int numWay;
+	int numRowPerSet;
+	bool split;
+	int numActiveSubarrayPerRow;
+	int numActiveSubarrayPerColumn;
+	int muxSenseAmp;
+	bool internalSenseAmp;
+	int muxOutputLev1;
+	int muxOutputLev2;
+	BufferDesignTarget areaOptimizationLevel;
+	MemoryType memoryType;
+	int stackedDieCount;
+	int partitionGranularity;
+	int monolithicStackCount;
+	const void *tech;
+	const void *devtech;
+	const void *cell;
+	const void *localWire;
+	int localWireType;
+	int localWireRepeaterType;
+	bool isLocalWireLowSwing;
+	double rampInput;
+
+	bool operator==(const MatKey &rhs) const;
+};
+
+struct MatKeyHash {
+	size_t operator()(const MatKey &key) const;
+};
+
+/* The results of Mat::CalculateLatency and Mat::CalculatePower that the bank and the result read.
+ * The predecoder blocks are not kept, only the predecoder latency is read outside of the mat */
+struct MatResult {
+	FunctionUnit mat;
+	double predecoderLatency;
+	SubArrayResult subarray;
+	FunctionUnit comparator;
+	FunctionUnit tsvArray;
+
+	void Save(const Mat &mat);
+	void Restore(Mat &mat) const;
+};
+
+/* Memoizes the mats of the explored designs, the MatResult after Mat::CalculateLatency and Mat::CalculatePower.
+ * The bank organizations that map to the same mat (for example those that only differ in the number of
+ * active mats) only pay for the routing and the TSVs of the bank. Mat::Initialize is not memoized: most
+ * mats are rejected by its first checks, and its subarray comes from the subarray cache.
+ * The cache is bounded in memory. Every thread has its own cache, so that no locking is needed */
+class MatCache {
+public:
+	MatCache();
+	virtual ~MatCache();
+
+	/* Functions */
+	static MatCache & ThreadCache();	/* The cache of the calling thread */
+	static MatKey MakeKey(int _numRowSubarray, int _numColumnSubarray, int _numAddressBit, long _numDataBit,
+			int _numWay, int _numRowPerSet, bool _split, int _numActiveSubarrayPerRow, int _numActiveSubarrayPerColumn,
+			int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
+			BufferDesignTarget _areaOptimizationLevel, MemoryType _memoryType, int _stackedDieCount,
+			int _partitionGranularity, int _monolithicStackCount);
+	bool Load(const MatKey &key, double rampInput, Mat &mat);
+	void Store(const MatKey &key, double rampInput, const Mat &mat);
+	static void PrintStatistics();	/* Hits and misses of all the threads, and the largest memory of a thread */
+
+	/* Properties */
+	long long numHit;
+	long long numMiss;
+	long long peakByte;	/* Largest memory used by the mats, Unit: byte */
+
+private:
+	unordered_map<MatKey, MatResult, MatKeyHash> entries;
+};
+
+#endif /* MATCACHE_H_ */
@@ -8,6 +8,7 @@
 #include "Mux.h"
 #include "global.h"
 #include "formula.h"
+#include "Profiler.h"
 
 Mux::Mux() {
 	// TODO Auto-generated constructor stub
@@ -23,6 +24,7 @@ Mux::~Mux() {
 }
 
 void Mux::Initialize(int _numInput, long long _numMux, double _capLoad, double _capInputNextStage, double _minDriverCurrent){
+	PROFILE(profile_mux_initialize);
 	if (initialized)
 		cout << "[Mux] Warning: Already initialized!" << endl;
 
@@ -52,6 +54,7 @@ void Mux::Initialize(int _numInput, long long _numMux, double _capLoad, double _
 }
 
 void Mux::CalculateArea(){
+	PROFILE(profile_mux_area);
 	if (!initialized) {
 		cout << "[Mux] Error: Require initialization first!" << endl;
 	} else {
@@ -68,6 +71,7 @@ void Mux::CalculateArea(){
 }
 
 void Mux::CalculateRC() {
+	PROFILE(profile_mux_rc);
 	if (!initialized) {
 		cout << "[Mux] Error: Require initialization first!" << endl;
 	} else {
@@ -84,6 +88,7 @@ void Mux::CalculateRC() {
 }
 
 void Mux::CalculateLatency(double _rampInput) {  //rampInput is actually useless in Mux module
+	PROFILE(profile_mux_latency);
 	if (!initialized) {
 		cout << "[Mux] Error: Require initialization first!" << endl;
 	} else {
@@ -100,6 +105,7 @@ void Mux::CalculateLatency(double _rampInput) {  //rampInput is actually useless
 }
 
 void Mux::CalculatePower() {
+	PROFILE(profile_mux_power);
 	if (!initialized) {
 		cout << "[Mux] Error: Require initialization first!" << endl;
 	} else {
@@ -127,6 +133,15 @@ Mux & Mux::operator=(const Mux &rhs) {
 	writeLatency = rhs.writeLatency;
 	readDynamicEnergy = rhs.readDynamicEnergy;
 	writeDynamicEnergy = rhs.writeDynamicEnergy;
+	resetLatency = rhs.resetLatency;
+	setLatency = rhs.setLatency;
+	refreshLatency = rhs.refreshLatency;
+	resetDynamicEnergy = rhs.resetDynamicEnergy;
+	setDynamicEnergy = rhs.setDynamicEnergy;
+	refreshDynamicEnergy = rhs.refreshDynamicEnergy;
+	cellReadEnergy = rhs.cellReadEnergy;
+	cellSetEnergy = rhs.cellSetEnergy;
+	cellResetEnergy = rhs.cellResetEnergy;
 	leakage = rhs.leakage;
 	initialized = rhs.initialized;
 	numInput = rhs.numInput;
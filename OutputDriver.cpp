@@ -9,6 +9,7 @@
 #include "OutputDriver.h"
 #include "global.h"
 #include "formula.h"
+#include "Profiler.h"
 #include <math.h>
 
 OutputDriver::OutputDriver() : FunctionUnit(){
@@ -22,6 +23,7 @@ OutputDriver::~OutputDriver() {
 
 void OutputDriver::Initialize(double _logicEffort, double _inputCap, double _outputCap, double _outputRes,
 		bool _inv, BufferDesignTarget _areaOptimizationLevel, double _minDriverCurrent) {
+	PROFILE(profile_output_driver_initialize);
 	if (initialized)
 		cout << "[Output Driver] Warning: Already initialized!" << endl;
 
@@ -140,6 +142,7 @@ void OutputDriver::Initialize(double _logicEffort, double _inputCap, double _out
 }
 
 void OutputDriver::CalculateArea() {
+	PROFILE(profile_output_driver_area);
 	if (!initialized) {
 		cout << "[Output Driver] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -160,6 +163,7 @@ void OutputDriver::CalculateArea() {
 }
 
 void OutputDriver::CalculateRC() {
+	PROFILE(profile_output_driver_rc);
 	if (!initialized) {
 		cout << "[Output Driver] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -174,6 +178,7 @@ void OutputDriver::CalculateRC() {
 }
 
 void OutputDriver::CalculateLatency(double _rampInput) {
+	PROFILE(profile_output_driver_latency);
 	if (!initialized) {
 		cout << "[Output Driver] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -209,6 +214,7 @@ void OutputDriver::CalculateLatency(double _rampInput) {
 }
 
 void OutputDriver::CalculatePower() {
+	PROFILE(profile_output_driver_power);
 	if (!initialized) {
 		cout << "[Output Driver] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -251,6 +257,8 @@ OutputDriver & OutputDriver::operator=(const OutputDriver &rhs) {
 	setLatency = rhs.setLatency;
 	resetDynamicEnergy = rhs.resetDynamicEnergy;
 	setDynamicEnergy = rhs.setDynamicEnergy;
+	refreshLatency = rhs.refreshLatency;
+	refreshDynamicEnergy = rhs.refreshDynamicEnergy;
 	cellReadEnergy = rhs.cellReadEnergy;
 	cellSetEnergy = rhs.cellSetEnergy;
 	cellResetEnergy = rhs.cellResetEnergy;
@@ -265,6 +273,12 @@ OutputDriver & OutputDriver::operator=(const OutputDriver &rhs) {
 	numStage = rhs.numStage;
 	areaOptimizationLevel = rhs.areaOptimizationLevel;
 	minDriverCurrent = rhs.minDriverCurrent;
+	for (int i = 0; i < MAX_INV_CHAIN_LEN; i++) {
+		widthNMOS[i] = rhs.widthNMOS[i];
+		widthPMOS[i] = rhs.widthPMOS[i];
+		capInput[i] = rhs.capInput[i];
+		capOutput[i] = rhs.capOutput[i];
+	}
 	rampInput = rhs.rampInput;
 	rampOutput = rhs.rampOutput;
 
@@ -0,0 +1,258 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "ParallelExplorer.h"
+#include "global.h"
+#include "macros.h"
+#include "BankPool.h"
+#include "Profiler.h"
+#include "constant.h"
+#include "formula.h"
+#include <iostream>
+#include <algorithm>
+#include <thread>
+
+ParallelExplorer::ParallelExplorer() {
+	numThreads = 1;
+	capacity = 0;
+	blockSize = 0;
+	associativity = 1;
+	partitionGranularity = 0;
+	numIndexBit = 0;
+	numOffsetBit = 0;
+	bestTagResults = NULL;
+	outputFile = NULL;
+	paretoArchive = NULL;
+	designStore = NULL;
+	searchBound = NULL;
+	numPruned = 0;
+	nextChunkToWrite = 0;
+}
+
+ParallelExplorer::~ParallelExplorer() {
+	// TODO Auto-generated destructor stub
+}
+
+void ParallelExplorer::Explore(ExplorationPass _pass, Result *bestResults, long long &numSolution, long long &numDesigns) {
+	pass = _pass;
+
+	/* Flatten the bank-level loops into chunks in the serial order */
+	int numRowMat, numColumnMat, stackedDieCount, numActiveMatPerRow, numActiveMatPerColumn;
+	organizations.clear();
+	BIGFOR_BANK {
+		BankOrganization organization;
+		organization.numRowMat = numRowMat;
+		organization.numColumnMat = numColumnMat;
+		organization.stackedDieCount = stackedDieCount;
+		organization.numActiveMatPerRow = numActiveMatPerRow;
+		organization.numActiveMatPerColumn = numActiveMatPerColumn;
+		organizations.push_back(organization);
+	}
+
+	int numWorker = MIN(numThreads, (int)organizations.size());
+	if (numWorker < 1)
+		numWorker = 1;
+
+	designFilter.Initialize();
+	nextChunk = 0;
+	pendingOutput.assign(organizations.size(), string());
+	chunkFinished.assign(organizations.size(), false);
+	nextChunkToWrite = 0;
+
+	WorkerResult *workerResults = new WorkerResult[numWorker];
+	for (int t = 0; t < numWorker; t++) {
+		workerResults[t].context = new EvalContext();
+		workerResults[t].context->Capture();
+		workerResults[t].best = new Result[(int)full_exploration];
+		for (int i = 0; i < (int)full_exploration; i++) {
+			workerResults[t].best[i].optimizationTarget = bestResults[i].optimizationTarget;
+			workerResults[t].best[i].cellTech = bestResults[i].cellTech;
+			workerResults[t].best[i].limitReadLatency = bestResults[i].limitReadLatency;
+			workerResults[t].best[i].limitWriteLatency = bestResults[i].limitWriteLatency;
+			workerResults[t].best[i].limitReadDynamicEnergy = bestResults[i].limitReadDynamicEnergy;
+			workerResults[t].best[i].limitWriteDynamicEnergy = bestResults[i].limitWriteDynamicEnergy;
+			workerResults[t].best[i].limitReadEdp = bestResults[i].limitReadEdp;
+			workerResults[t].best[i].limitWriteEdp = bestResults[i].limitWriteEdp;
+			workerResults[t].best[i].limitArea = bestResults[i].limitArea;
+			workerResults[t].best[i].limitLeakage = bestResults[i].limitLeakage;
+			workerResults[t].sequence[i] = -1;
+		}
+		workerResults[t].numSolution = 0;
+		workerResults[t].numDesigns = 0;
+		workerResults[t].numPruned = 0;
+		workerResults[t].designFilter = designFilter;
+		if (searchBound && pass == data_pass)
+			workerResults[t].searchBound = *searchBound;
+	}
+
+	vector<thread> workers;
+	for (int t = 0; t < numWorker; t++)
+		workers.push_back(thread(&ParallelExplorer::Work, this, &workerResults[t]));
+	for (int t = 0; t < numWorker; t++)
+		workers[t].join();
+
+	/* Merge the worker bests in the serial order, so that ties are resolved the same way as the serial loop */
+	for (int i = 0; i < (int)full_exploration; i++) {
+		vector<pair<long long, int> > candidates;
+		for (int t = 0; t < numWorker; t++)
+			if (workerResults[t].sequence[i] >= 0)
+				candidates.push_back(make_pair(workerResults[t].sequence[i], t));
+		sort(candidates.begin(), candidates.end());
+		for (int c = 0; c < (int)candidates.size(); c++)
+			bestResults[i].compareAndUpdate(workerResults[candidates[c].second].best[i]);
+	}
+
+	if (paretoArchive && pass == data_pass)
+		for (int t = 0; t < numWorker; t++)
+			paretoArchive->Merge(workerResults[t].archive);
+
+	if (designStore && pass == data_pass) {
+		for (int t = 0; t < numWorker; t++)
+			designStore->Merge(workerResults[t].store);
+		designStore->Sort();
+	}
+
+	for (int t = 0; t < numWorker; t++) {
+		numSolution += workerResults[t].numSolution;
+		numDesigns += workerResults[t].numDesigns;
+		numPruned += workerResults[t].numPruned;
+		designFilter.Merge(workerResults[t].designFilter);
+		delete [] workerResults[t].best;
+		delete workerResults[t].context;
+	}
+	delete [] workerResults;
+
+	organizations.clear();
+	pendingOutput.clear();
+	chunkFinished.clear();
+}
+
+void ParallelExplorer::Work(WorkerResult *workerResult) {
+	workerResult->context->Bind();
+
+	int chunkIdx;
+	while ((chunkIdx = nextChunk++) < (int)organizations.size()) {
+		CsvWriter chunkOutput;
+		EvaluateChunk(chunkIdx, workerResult, chunkOutput);
+		if (outputFile)
+			WriteChunk(chunkIdx, chunkOutput.Take());
+	}
+
+	localWire = NULL;
+	globalWire = NULL;
+	cell = NULL;
+	tech = NULL;
+	devtech = NULL;
+	inputParameter = NULL;
+}
+
+void ParallelExplorer::EvaluateChunk(int chunkIdx, WorkerResult *workerResult, CsvWriter &outputFile) {
+	int numRowMat = organizations[chunkIdx].numRowMat;
+	int numColumnMat = organizations[chunkIdx].numColumnMat;
+	int stackedDieCount = organizations[chunkIdx].stackedDieCount;
+	int numActiveMatPerRow = organizations[chunkIdx].numActiveMatPerRow;
+	int numActiveMatPerColumn = organizations[chunkIdx].numActiveMatPerColumn;
+	int numRowSubarray, numColumnSubarray, numActiveSubarrayPerRow, numActiveSubarrayPerColumn;
+	int muxSenseAmp, muxOutputLev1, muxOutputLev2, numRowPerSet;
+	int areaOptimizationLevel;
+	long long capacity = this->capacity;
+	long blockSize = this->blockSize;
+	int associativity = this->associativity;
+	int partitionGranularity = this->partitionGranularity;
+	Result *bestTagResults = this->bestTagResults;
+	Result *best = workerResult->best;
+	EvalContext *evalContext = workerResult->context;
+
+	Bank *dataBank, *tagBank;
+	Result tempResult;
+	long long sequence = (long long)chunkIdx << 32;
+
+	/* The bound is checked against the best of this worker, which is never better than the merged one */
+	SearchBound *searchBound = &(workerResult->searchBound);
+	if (searchBound->Prune(best[searchBound->optimizationTarget], numRowMat, numColumnMat, stackedDieCount,
+			numActiveMatPerRow, numActiveMatPerColumn)) {
+		/* Only the designs that the exhaustive search counts in numDesigns */
+		BIGFOR_MAT
+			if (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) > 0)
+				workerResult->numPruned++;
+		return;
+	}
+
+	BIGFOR_MAT {
+		sequence++;
+		if (pass == tag_pass) {
+			blockSize = TOTAL_ADDRESS_BIT - numIndexBit - numOffsetBit;
+			blockSize += 2;		/* add dirty bits and valid bits */
+			if (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) == 0) {
+				/* To aggressive partitioning */
+				continue;
+			}
+			if (blockSize % (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn)) {
+				blockSize = (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) + 1)
+						* (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn);
+			}
+			capacity = (long long)inputParameter->capacity * 8 / inputParameter->wordWidth * blockSize;
+			associativity = inputParameter->associativity;
+			workerResult->numDesigns++;
+			if (REJECT(workerResult->designFilter, tag))
+				continue;
+			CALCULATE(tagBank, tag);
+			if (!tagBank->invalid) {
+				VERIFY_TAG_CAPACITY;
+				workerResult->numSolution++;
+				*(tempResult.bank) = *tagBank;
+				*(tempResult.localWire) = *localWire;
+				*(tempResult.globalWire) = *globalWire;
+				for (int i = 0; i < (int)full_exploration; i++)
+					if (best[i].compareAndUpdate(tempResult))
+						workerResult->sequence[i] = sequence;
+			}
+			BankPool::ThreadPool().Release(tagBank);
+		} else {
+			if (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) == 0) {
+				/* To aggressive partitioning */
+				continue;
+			}
+			workerResult->numDesigns++;
+			if (REJECT(workerResult->designFilter, MemoryType::data))
+				continue;
+			CALCULATE(dataBank, MemoryType::data);
+			searchBound->Record(*dataBank);
+			if (!dataBank->invalid) {
+				VERIFY_DATA_CAPACITY;
+				workerResult->numSolution++;
+				if (designStore && pass == data_pass)
+					workerResult->store.Insert(*dataBank, *localWire, *globalWire, sequence);
+				if (paretoArchive && pass == data_pass) {
+					workerResult->archive.Insert(*dataBank, *localWire, *globalWire);
+				} else {
+					*(tempResult.bank) = *dataBank;
+					*(tempResult.localWire) = *localWire;
+					*(tempResult.globalWire) = *globalWire;
+					for (int i = 0; i < (int)full_exploration; i++)
+						if (best[i].compareAndUpdate(tempResult))
+							workerResult->sequence[i] = sequence;
+				}
+				if (this->outputFile) {
+					OUTPUT_TO_FILE;
+				}
+			}
+			BankPool::ThreadPool().Release(dataBank);
+		}
+	}
+	searchBound->FinishOrganization();
+}
+
+void ParallelExplorer::WriteChunk(int chunkIdx, const string &output) {
+	lock_guard<mutex> lock(outputMutex);
+	pendingOutput[chunkIdx] = output;
+	chunkFinished[chunkIdx] = true;
+	while (nextChunkToWrite < (int)organizations.size() && chunkFinished[nextChunkToWrite]) {
+		outputFile->Write(pendingOutput[nextChunkToWrite]);
+		string().swap(pendingOutput[nextChunkToWrite]);
+		nextChunkToWrite++;
+	}
+}
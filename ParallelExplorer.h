@@ -0,0 +1,95 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef PARALLELEXPLORER_H_
+#define PARALLELEXPLORER_H_
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include "Result.h"
+#include "EvalContext.h"
+#include "ParetoArchive.h"
+#include "SearchBound.h"
+#include "DesignStore.h"
+#include "DesignFilter.h"
+#include "CsvWriter.h"
+#include "typedef.h"
+
+using namespace std;
+
+/* The BIGFOR pass of nvsim() that is explored in parallel */
+enum ExplorationPass {
+	tag_pass,			/* Cache tag array */
+	data_pass			/* Cache data array or memory array */
+};
+
+class ParallelExplorer {
+public:
+	ParallelExplorer();
+	virtual ~ParallelExplorer();
+
+	/* Functions */
+	void Explore(ExplorationPass _pass, Result *bestResults, long long &numSolution, long long &numDesigns);
+
+	/* Properties */
+	int numThreads;			/* Number of worker threads */
+	long long capacity;		/* Capacity of the data array, Unit: bit */
+	long blockSize;			/* Block size of the data array, Unit: bit */
+	int associativity;		/* Associativity of the data array */
+	int partitionGranularity;
+	int numIndexBit;		/* Tag pass only */
+	int numOffsetBit;		/* Tag pass only */
+	Result *bestTagResults;	/* The tag arrays that cache designs are printed with */
+	CsvWriter *outputFile;	/* Valid designs are printed here in the serial order, NULL if not printed */
+	ParetoArchive *paretoArchive;	/* Data pass only, valid designs are inserted here instead of searching the best results if not NULL */
+	DesignStore *designStore;	/* Data pass only, valid designs are also recorded here in the serial order if not NULL */
+	const SearchBound *searchBound;	/* Data pass only, every worker prunes the bank organizations with a copy of it if not NULL */
+	long long numPruned;	/* Number of mat-level designs skipped by searchBound */
+	DesignFilter designFilter;	/* The designs rejected by the workers */
+
+private:
+	/* One chunk of work: a bank organization, the remaining mat-level loops are run by the worker */
+	struct BankOrganization {
+		int numRowMat;
+		int numColumnMat;
+		int stackedDieCount;
+		int numActiveMatPerRow;
+		int numActiveMatPerColumn;
+	};
+
+	/* Best results of a worker and the sequence number of the design that produced each of them */
+	struct WorkerResult {
+		EvalContext *context;	/* Private evaluation state of the worker */
+		Result *best;
+		ParetoArchive archive;
+		DesignStore store;
+		SearchBound searchBound;	/* Copy of the shared one, with the records of this worker */
+		DesignFilter designFilter;
+		long long sequence[(int)full_exploration];
+		long long numSolution;
+		long long numDesigns;
+		long long numPruned;
+	};
+
+	void Work(WorkerResult *workerResult);
+	void EvaluateChunk(int chunkIdx, WorkerResult *workerResult, CsvWriter &outputFile);
+	void WriteChunk(int chunkIdx, const string &output);
+
+	ExplorationPass pass;
+	vector<BankOrganization> organizations;
+	atomic<int> nextChunk;
+
+	/* Output of finished chunks that can not be written until all the earlier chunks are written */
+	mutex outputMutex;
+	vector<string> pendingOutput;
+	vector<bool> chunkFinished;
+	int nextChunkToWrite;
+};
+
+#endif /* PARALLELEXPLORER_H_ */
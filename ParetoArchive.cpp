@@ -0,0 +1,140 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "ParetoArchive.h"
+#include <algorithm>
+
+void DesignPoint::Set(const Bank &bank, const Wire &localWire, const Wire &globalWire) {
+	numRowMat = bank.numRowMat;
+	numColumnMat = bank.numColumnMat;
+	numActiveMatPerRow = bank.numActiveMatPerRow;
+	numActiveMatPerColumn = bank.numActiveMatPerColumn;
+	numRowSubarray = bank.numRowSubarray;
+	numColumnSubarray = bank.numColumnSubarray;
+	numActiveSubarrayPerRow = bank.numActiveSubarrayPerRow;
+	numActiveSubarrayPerColumn = bank.numActiveSubarrayPerColumn;
+	muxSenseAmp = bank.muxSenseAmp;
+	muxOutputLev1 = bank.muxOutputLev1;
+	muxOutputLev2 = bank.muxOutputLev2;
+	numRowPerSet = bank.numRowPerSet;
+	stackedDieCount = bank.stackedDieCount;
+	partitionGranularity = bank.partitionGranularity;
+	areaOptimizationLevel = bank.areaOptimizationLevel;
+	localWireType = localWire.wireType;
+	localWireRepeaterType = localWire.wireRepeaterType;
+	isLocalWireLowSwing = localWire.isLowSwing;
+	globalWireType = globalWire.wireType;
+	globalWireRepeaterType = globalWire.wireRepeaterType;
+	isGlobalWireLowSwing = globalWire.isLowSwing;
+}
+
+bool DesignPoint::operator<(const DesignPoint &rhs) const {
+	/* Field by field, only used to order designs with the same metrics */
+	const int lhsFields[] = {numRowMat, numColumnMat, stackedDieCount, numActiveMatPerRow, numActiveMatPerColumn,
+			numRowSubarray, numColumnSubarray, numActiveSubarrayPerRow, numActiveSubarrayPerColumn,
+			muxSenseAmp, muxOutputLev1, muxOutputLev2, numRowPerSet, areaOptimizationLevel, partitionGranularity,
+			localWireType, localWireRepeaterType, isLocalWireLowSwing, globalWireType, globalWireRepeaterType, isGlobalWireLowSwing};
+	const int rhsFields[] = {rhs.numRowMat, rhs.numColumnMat, rhs.stackedDieCount, rhs.numActiveMatPerRow, rhs.numActiveMatPerColumn,
+			rhs.numRowSubarray, rhs.numColumnSubarray, rhs.numActiveSubarrayPerRow, rhs.numActiveSubarrayPerColumn,
+			rhs.muxSenseAmp, rhs.muxOutputLev1, rhs.muxOutputLev2, rhs.numRowPerSet, rhs.areaOptimizationLevel, rhs.partitionGranularity,
+			rhs.localWireType, rhs.localWireRepeaterType, rhs.isLocalWireLowSwing, rhs.globalWireType, rhs.globalWireRepeaterType, rhs.isGlobalWireLowSwing};
+	return lexicographical_compare(lhsFields, lhsFields + sizeof(lhsFields) / sizeof(int), rhsFields, rhsFields + sizeof(rhsFields) / sizeof(int));
+}
+
+ParetoArchive::ParetoArchive() {
+	numInserted = 0;
+}
+
+ParetoArchive::~ParetoArchive() {
+	// TODO Auto-generated destructor stub
+}
+
+bool ParetoArchive::Insert(const double *newMetrics, const DesignPoint &point) {
+	numInserted++;
+	/* Remove the members that the new design dominates while looking for a member that dominates it.
+	 * Since the members do not dominate each other, a member that dominates the new design can only be
+	 * found before anything is removed */
+	int numMember = (int)points.size();
+	int numKept = 0;
+	for (int i = 0; i < numMember; i++) {
+		bool noWorse = true, noBetter = true;	/* Member compared to the new design */
+		for (int m = 0; m < num_pareto_metric; m++) {
+			double value = metrics[m][i];
+			noWorse = noWorse && value <= newMetrics[m];
+			noBetter = noBetter && value >= newMetrics[m];
+		}
+		if (noWorse && !noBetter)
+			return false;
+		if (noBetter && !noWorse)
+			continue;	/* Dominated */
+		if (numKept != i) {
+			for (int m = 0; m < num_pareto_metric; m++)
+				metrics[m][numKept] = metrics[m][i];
+			points[numKept] = points[i];
+		}
+		numKept++;
+	}
+	for (int m = 0; m < num_pareto_metric; m++) {
+		metrics[m].resize(numKept);
+		metrics[m].push_back(newMetrics[m]);
+	}
+	points.resize(numKept);
+	points.push_back(point);
+	return true;
+}
+
+bool ParetoArchive::Insert(const Bank &bank, const Wire &localWire, const Wire &globalWire) {
+	double newMetrics[num_pareto_metric];
+	newMetrics[pareto_read_latency] = bank.readLatency;
+	newMetrics[pareto_write_latency] = bank.writeLatency;
+	newMetrics[pareto_read_dynamic_energy] = bank.readDynamicEnergy;
+	newMetrics[pareto_write_dynamic_energy] = bank.writeDynamicEnergy;
+	newMetrics[pareto_leakage] = bank.leakage;
+	newMetrics[pareto_area] = bank.area;
+	DesignPoint point;
+	point.Set(bank, localWire, globalWire);
+	return Insert(newMetrics, point);
+}
+
+void ParetoArchive::Merge(const ParetoArchive &other) {
+	double otherMetrics[num_pareto_metric];
+	for (int i = 0; i < other.Size(); i++) {
+		for (int m = 0; m < num_pareto_metric; m++)
+			otherMetrics[m] = other.metrics[m][i];
+		Insert(otherMetrics, other.points[i]);
+	}
+	numInserted += other.numInserted - other.Size();
+}
+
+void ParetoArchive::Sort() {
+	vector<int> order(points.size());
+	for (int i = 0; i < (int)order.size(); i++)
+		order[i] = i;
+	sort(order.begin(), order.end(), [this](int a, int b) {
+		for (int m = 0; m < num_pareto_metric; m++)
+			if (metrics[m][a] != metrics[m][b])
+				return metrics[m][a] < metrics[m][b];
+		return points[a] < points[b];
+	});
+
+	vector<double> sortedMetrics(order.size());
+	for (int m = 0; m < num_pareto_metric; m++) {
+		for (int i = 0; i < (int)order.size(); i++)
+			sortedMetrics[i] = metrics[m][order[i]];
+		metrics[m].swap(sortedMetrics);
+	}
+	vector<DesignPoint> sortedPoints(order.size());
+	for (int i = 0; i < (int)order.size(); i++)
+		sortedPoints[i] = points[order[i]];
+	points.swap(sortedPoints);
+}
+
+void ParetoArchive::Clear() {
+	for (int m = 0; m < num_pareto_metric; m++)
+		metrics[m].clear();
+	points.clear();
+	numInserted = 0;
+}
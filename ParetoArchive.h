@@ -0,0 +1,82 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef PARETOARCHIVE_H_
+#define PARETOARCHIVE_H_
+
+#include <vector>
+#include "Bank.h"
+#include "Wire.h"
+
+using namespace std;
+
+/* The metrics that the Pareto frontier is built on, all of them are minimized */
+enum ParetoMetric {
+	pareto_read_latency = 0,
+	pareto_write_latency = 1,
+	pareto_read_dynamic_energy = 2,
+	pareto_write_dynamic_energy = 3,
+	pareto_leakage = 4,
+	pareto_area = 5,
+	num_pareto_metric = 6
+};
+
+/* Everything that is needed to calculate a design again, the array size comes from the exploration */
+struct DesignPoint {
+	int numRowMat;
+	int numColumnMat;
+	int numActiveMatPerRow;
+	int numActiveMatPerColumn;
+	int numRowSubarray;
+	int numColumnSubarray;
+	int numActiveSubarrayPerRow;
+	int numActiveSubarrayPerColumn;
+	short muxSenseAmp;
+	short muxOutputLev1;
+	short muxOutputLev2;
+	short numRowPerSet;
+	short stackedDieCount;
+	char partitionGranularity;
+	char areaOptimizationLevel;		/* BufferDesignTarget */
+	char localWireType;				/* WireType */
+	char localWireRepeaterType;		/* WireRepeaterType */
+	char isLocalWireLowSwing;
+	char globalWireType;
+	char globalWireRepeaterType;
+	char isGlobalWireLowSwing;
+
+	void Set(const Bank &bank, const Wire &localWire, const Wire &globalWire);
+	bool operator<(const DesignPoint &rhs) const;
+};
+
+/* The designs that are not dominated by any other design seen so far. A design dominates another one
+ * if it is no worse in every metric and better in at least one, designs with the same metrics are all kept,
+ * so the frontier does not depend on the order in which the designs are inserted.
+ * The metrics are stored one array per metric, the dominance test only walks these arrays */
+class ParetoArchive {
+public:
+	ParetoArchive();
+	virtual ~ParetoArchive();
+
+	/* Functions */
+	bool Insert(const double *metrics, const DesignPoint &point);	/* Returns whether the design is on the frontier */
+	bool Insert(const Bank &bank, const Wire &localWire, const Wire &globalWire);
+	void Merge(const ParetoArchive &other);
+	void Sort();	/* Order by the metrics in the ParetoMetric order, so that the output is deterministic */
+	void Clear();
+	int Size() const { return (int)points.size(); }
+	const DesignPoint & Point(int i) const { return points[i]; }
+	double Metric(ParetoMetric metric, int i) const { return metrics[metric][i]; }
+
+	/* Properties */
+	long long numInserted;	/* Number of designs offered to the archive */
+
+private:
+	vector<double> metrics[num_pareto_metric];
+	vector<DesignPoint> points;
+};
+
+#endif /* PARETOARCHIVE_H_ */
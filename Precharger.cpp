@@ -9,6 +9,7 @@
 #include "Precharger.h"
 #include "formula.h"
 #include "global.h"
+#include "Profiler.h"
 
 Precharger::Precharger() {
 	// TODO Auto-generated constructor stub
@@ -21,6 +22,7 @@ Precharger::~Precharger() {
 }
 
 void Precharger::Initialize(double _voltagePrecharge, int _numColumn, double _capBitline, double _resBitline){
+	PROFILE(profile_precharger_initialize);
 	if (initialized)
 		cout << "[Precharger] Warning: Already initialized!" << endl;
 
@@ -47,6 +49,7 @@ void Precharger::Initialize(double _voltagePrecharge, int _numColumn, double _ca
 }
 
 void Precharger::CalculateArea() {
+	PROFILE(profile_precharger_area);
 	if (!initialized) {
 		cout << "[Precharger] Error: Require initialization first!" << endl;
 	} else {
@@ -69,6 +72,7 @@ void Precharger::CalculateArea() {
 }
 
 void Precharger::CalculateRC() {
+	PROFILE(profile_precharger_rc);
 	if (!initialized) {
 		cout << "[Precharger] Error: Require initialization first!" << endl;
 	} else {
@@ -78,6 +82,7 @@ void Precharger::CalculateRC() {
 }
 
 void Precharger::CalculateLatency(double _rampInput){
+	PROFILE(profile_precharger_latency);
 	if (!initialized) {
 		cout << "[Precharger] Error: Require initialization first!" << endl;
 	} else {
@@ -107,6 +112,7 @@ void Precharger::CalculateLatency(double _rampInput){
 }
 
 void Precharger::CalculatePower() {
+	PROFILE(profile_precharger_power);
 	if (!initialized) {
 		cout << "[Precharger] Error: Require initialization first!" << endl;
 	} else {
@@ -151,6 +157,7 @@ Precharger & Precharger::operator=(const Precharger &rhs) {
 	leakage = rhs.leakage;
 	initialized = rhs.initialized;
 	outputDriver = rhs.outputDriver;
+	voltagePrecharge = rhs.voltagePrecharge;
 	capBitline = rhs.capBitline;
 	resBitline = rhs.resBitline;
 	capLoadInv = rhs.capLoadInv;
@@ -161,6 +168,8 @@ Precharger & Precharger::operator=(const Precharger &rhs) {
 	numColumn = rhs.numColumn;
 	widthPMOSBitlinePrecharger = rhs.widthPMOSBitlinePrecharger;
 	widthPMOSBitlineEqual = rhs.widthPMOSBitlineEqual;
+	widthInvNmos = rhs.widthInvNmos;
+	widthInvPmos = rhs.widthInvPmos;
 	capLoadPerColumn = rhs.capLoadPerColumn;
 	rampInput = rhs.rampInput;
 	rampOutput = rhs.rampOutput;
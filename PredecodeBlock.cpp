@@ -7,41 +7,19 @@
 #include "PredecodeBlock.h"
 #include "formula.h"
 #include "global.h"
+#include "Profiler.h"
 
 PredecodeBlock::PredecodeBlock() {
 	// TODO Auto-generated constructor stub
 	initialized = false;
-	rowDecoderStage1A = NULL;
-	rowDecoderStage1B = NULL;
-	rowDecoderStage1C = NULL;
-	rowDecoderStage2 = NULL;
-	basicDecoderA1 = NULL;
-	basicDecoderA2 = NULL;
-	basicDecoderB = NULL;
-	basicDecoderC = NULL;
 }
 
 PredecodeBlock::~PredecodeBlock() {
 	// TODO Auto-generated destructor stub
-	if (rowDecoderStage1A)
-		delete rowDecoderStage1A;
-	if (rowDecoderStage1B)
-		delete rowDecoderStage1B;
-	if (rowDecoderStage1C)
-		delete rowDecoderStage1C;
-	if (rowDecoderStage2)
-		delete rowDecoderStage2;
-	if (basicDecoderA1)
-		delete basicDecoderA1;
-	if (basicDecoderA2)
-		delete basicDecoderA2;
-	if (basicDecoderB)
-		delete basicDecoderB;
-	if (basicDecoderC)
-		delete basicDecoderC;
 }
 
 void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _resLoad) {
+	PROFILE(profile_predecode_initialize);
 	if (initialized)
 		cout << "[Predecoder Block] Warning: Already initialized!" << endl;
 
@@ -74,20 +52,20 @@ void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _res
 		}
 		int numBasicDecoder = numDecoder12 + numDecoder24 + numDecoder38;
 		if (numBasicDecoder <= 1){
-			rowDecoderStage1A = NULL;
-			rowDecoderStage1B = NULL;
-			rowDecoderStage1C = NULL;
-			rowDecoderStage2 = NULL;
+			rowDecoderStage1A.reset();
+			rowDecoderStage1B.reset();
+			rowDecoderStage1C.reset();
+			rowDecoderStage2.reset();
 		} else if (numBasicDecoder <= 3) {
 			numNandInputStage1A = numBasicDecoder;
-			rowDecoderStage2 = NULL;
-			rowDecoderStage1B = NULL;
-			rowDecoderStage1C = NULL;
-			rowDecoderStage1A = new RowDecoder;
+			rowDecoderStage2.reset();
+			rowDecoderStage1B.reset();
+			rowDecoderStage1C.reset();
+			rowDecoderStage1A.emplace();
 			rowDecoderStage1A->Initialize(numOutputAddressBit, capLoad, resLoad, numNandInputStage1A == 3, latency_first, 0);
 			rowDecoderStage1A->CalculateRC();
 		} else {
-			rowDecoderStage2 = new RowDecoder;
+			rowDecoderStage2.emplace();
 			double capLoadStage1A, capLoadStage1B, capLoadStage1C;
 			if (numBasicDecoder <= 6) {
 				rowDecoderStage2->Initialize(numOutputAddressBit, capLoad, resLoad, false, latency_first, 0);
@@ -100,11 +78,11 @@ void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _res
 				numAddressBitStage1B <<= 3 * numNandInputStage1B;
 				capLoadStage1A = numAddressBitStage1B * rowDecoderStage2->capNandInput;
 				capLoadStage1B = numAddressBitStage1A * rowDecoderStage2->capNandInput;
-				rowDecoderStage1C = NULL;
-				rowDecoderStage1A = new RowDecoder;
+				rowDecoderStage1C.reset();
+				rowDecoderStage1A.emplace();
 			    rowDecoderStage1A->Initialize(numAddressBitStage1A, capLoadStage1A, 0 /* TO-DO */, numNandInputStage1A == 3, latency_first, 0);
 			    rowDecoderStage1A->CalculateRC();
-			    rowDecoderStage1B = new RowDecoder;
+			    rowDecoderStage1B.emplace();
 			    rowDecoderStage1B->Initialize(numAddressBitStage1B, capLoadStage1B, 0 /* TO-DO */, numNandInputStage1B == 3, latency_first, 0);
 			    rowDecoderStage1B->CalculateRC();
 			} else if (numBasicDecoder <= 9){
@@ -134,49 +112,49 @@ void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _res
 				capLoadStage1A = numAddressBitStage1B * numAddressBitStage1C * rowDecoderStage2->capNandInput;
 				capLoadStage1B = numAddressBitStage1A * numAddressBitStage1C * rowDecoderStage2->capNandInput;
 				capLoadStage1C = numAddressBitStage1A * numAddressBitStage1B * rowDecoderStage2->capNandInput;
-				rowDecoderStage1A = new RowDecoder;
+				rowDecoderStage1A.emplace();
 				rowDecoderStage1A->Initialize(numAddressBitStage1A, capLoadStage1A, 0 /* TO-DO */, numNandInputStage1A == 3, latency_first, 0);
 				rowDecoderStage1A->CalculateRC();
-				rowDecoderStage1B = new RowDecoder;
+				rowDecoderStage1B.emplace();
 				rowDecoderStage1B->Initialize(numAddressBitStage1B, capLoadStage1B, 0 /* TO-DO */, numNandInputStage1B == 3, latency_first, 0);
 				rowDecoderStage1B->CalculateRC();
-				rowDecoderStage1C = new RowDecoder;
+				rowDecoderStage1C.emplace();
 				rowDecoderStage1C->Initialize(numAddressBitStage1C, capLoadStage1C, 0 /* TO-DO */, numNandInputStage1C == 3, latency_first, 0);
 				rowDecoderStage1C->CalculateRC();
 			}
 		}
-		if (rowDecoderStage1C != NULL) {
+		if (rowDecoderStage1C) {
 			if (numNandInputStage1C == 2){
 				capLoadBasicDecoderC = 8 * rowDecoderStage1C->capNandInput;
 			} else {
 				capLoadBasicDecoderC = 64 * rowDecoderStage1C->capNandInput;
 			}
-			basicDecoderC = new BasicDecoder;
+			basicDecoderC.emplace();
 			basicDecoderC->Initialize(3, capLoadBasicDecoderC, 0 /* TO-DO */);
 		} else {
-			basicDecoderC = NULL;
+			basicDecoderC.reset();
 		}
-		if (rowDecoderStage1B != NULL) {
+		if (rowDecoderStage1B) {
 			if (numNandInputStage1B == 2){
 				capLoadBasicDecoderB = 8 * rowDecoderStage1B->capNandInput;
 			} else {
 				capLoadBasicDecoderB = 64 * rowDecoderStage1B->capNandInput;
 			}
-			basicDecoderB = new BasicDecoder;
+			basicDecoderB.emplace();
 			basicDecoderB->Initialize(3, capLoadBasicDecoderB, 0 /* TO-DO */);
 		} else {
-			basicDecoderB = NULL;
+			basicDecoderB.reset();
 		}
-		if (rowDecoderStage1A != NULL) {
+		if (rowDecoderStage1A) {
 			int numCapNandA1, numCapNandA2;
 			if (numDecoder24 == 0) {
 				numBasicDecoderA1 = numNandInputStage1A;
 				numBasicDecoderA2 = 0;
 				numCapNandA1 = 1 << ( 3* (numNandInputStage1A - 1));
 				capLoadBasicDecoderA1 = numCapNandA1 * rowDecoderStage1A->capNandInput;
-				basicDecoderA1 = new BasicDecoder;
+				basicDecoderA1.emplace();
 				basicDecoderA1->Initialize(3, capLoadBasicDecoderA1, 0 /* TO-DO */);
-				basicDecoderA2 = NULL;
+				basicDecoderA2.reset();
 			} else if (numDecoder24 == 1) {
 				numBasicDecoderA1 = 1;
 				numBasicDecoderA2 = numNandInputStage1A - numBasicDecoderA1;
@@ -184,31 +162,31 @@ void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _res
 				numCapNandA2 = 1 << (2 + 3 * (numBasicDecoderA2 - 1));
 				capLoadBasicDecoderA1 = numCapNandA1 * rowDecoderStage1A->capNandInput;
 				capLoadBasicDecoderA2 = numCapNandA2 * rowDecoderStage1A->capNandInput;
-				basicDecoderA1 = new BasicDecoder;
+				basicDecoderA1.emplace();
 			    basicDecoderA1->Initialize(2, capLoadBasicDecoderA1, 0 /* TO-DO */);
-			    basicDecoderA2 = new BasicDecoder;
+			    basicDecoderA2.emplace();
 			    basicDecoderA2->Initialize(3, capLoadBasicDecoderA2, 0 /* TO-DO */);
 			} else if (numDecoder24 == 2) {
 				if (numNandInputStage1A == 2) {
 		    		numBasicDecoderA1 = 2;
 		    		numBasicDecoderA2 = 0;
-		    		basicDecoderA1 = new BasicDecoder;
+		    		basicDecoderA1.emplace();
 		    		basicDecoderA1->Initialize(2, 4 * rowDecoderStage1A->capNandInput, 0 /* TO-DO */);
-		    		basicDecoderA2 = NULL;
+		    		basicDecoderA2.reset();
 				} else {
 		    		numBasicDecoderA1 = 2;
 		    		numBasicDecoderA2 = 1;
-		    		basicDecoderA1 = new BasicDecoder;
+		    		basicDecoderA1.emplace();
 		    		basicDecoderA1->Initialize(2, 32 * rowDecoderStage1A->capNandInput, 0 /* TO-DO */);
-		    		basicDecoderA2 = new BasicDecoder;
+		    		basicDecoderA2.emplace();
 		    		basicDecoderA2->Initialize(3, 16 * rowDecoderStage1A->capNandInput, 0 /* TO-DO */);
 				}
 			}
 		}else {
 			numBasicDecoderA1 = 1;
 			numBasicDecoderA2 = 0;
-			basicDecoderA1 = new BasicDecoder;
-			basicDecoderA2 = NULL;
+			basicDecoderA1.emplace();
+			basicDecoderA2.reset();
 			if (numDecoder12 == 1) {
 				basicDecoderA1->Initialize(1, capLoad, resLoad);
 			} else if (numDecoder24 == 1) {
@@ -221,6 +199,7 @@ void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _res
 }
 
 void PredecodeBlock::CalculateArea() {
+	PROFILE(profile_predecode_area);
 	if (!initialized) {
 		cout << "[Predecoder Block] Error: Require initialization first!" << endl;
 	} else if (numAddressBit == 0) {
@@ -228,20 +207,20 @@ void PredecodeBlock::CalculateArea() {
 	} else {
 		double hTemp,wTemp;
 		hTemp = wTemp = 0;
-		if (basicDecoderA1 != NULL) {
+		if (basicDecoderA1) {
 			basicDecoderA1->CalculateArea();
 			wTemp = max(wTemp, basicDecoderA1->width);
 			hTemp += numBasicDecoderA1 * basicDecoderA1->height;
-			if (basicDecoderA2 != NULL) {
+			if (basicDecoderA2) {
 				basicDecoderA2->CalculateArea();
 				wTemp = max(wTemp, basicDecoderA2->width);
 				hTemp += numBasicDecoderA2 * basicDecoderA2->height;
 			}
-			if (basicDecoderB != NULL) {
+			if (basicDecoderB) {
 				basicDecoderB->CalculateArea();
 				wTemp = max(wTemp, basicDecoderB->width);
 				hTemp += numNandInputStage1B * basicDecoderB->height;
-				if (basicDecoderC != NULL) {
+				if (basicDecoderC) {
 					basicDecoderC->CalculateArea();
 					wTemp = max(wTemp, basicDecoderC->width);
 					hTemp += numNandInputStage1C * basicDecoderC->height;
@@ -251,21 +230,21 @@ void PredecodeBlock::CalculateArea() {
 		width = wTemp;
 		height = hTemp;
 		hTemp = wTemp = 0;
-		if (rowDecoderStage1A != NULL) {
+		if (rowDecoderStage1A) {
 			rowDecoderStage1A->CalculateArea();
 			wTemp = max(wTemp, rowDecoderStage1A->width);
 			hTemp += rowDecoderStage1A->height;
-			if (rowDecoderStage1B != NULL) {
+			if (rowDecoderStage1B) {
 				rowDecoderStage1B->CalculateArea();
 				wTemp = max(wTemp, rowDecoderStage1B->width);
 				hTemp += rowDecoderStage1B->height;
-				if (rowDecoderStage1C != NULL) {
+				if (rowDecoderStage1C) {
 					rowDecoderStage1C->CalculateArea();
 					wTemp = max(wTemp, rowDecoderStage1C->width);
 					hTemp += rowDecoderStage1C->height;
 				}
 			}
-			if (rowDecoderStage2 != NULL) {
+			if (rowDecoderStage2) {
 				rowDecoderStage2->CalculateArea();
 				wTemp += rowDecoderStage2->width;
 				hTemp = max(hTemp, rowDecoderStage2->height);
@@ -278,17 +257,18 @@ void PredecodeBlock::CalculateArea() {
 }
 
 void PredecodeBlock::CalculateRC() {
+	PROFILE(profile_predecode_rc);
 	if (!initialized) {
 		cout << "[Predecoder Block] Error: Require initialization first!" << endl;
 	} else if (numAddressBit > 0) {
-		if (basicDecoderA1 != NULL) {
+		if (basicDecoderA1) {
 			basicDecoderA1->CalculateRC();
-			if (basicDecoderA2 != NULL) {
+			if (basicDecoderA2) {
 				basicDecoderA2->CalculateRC();
 			}
-			if (basicDecoderB != NULL) {
+			if (basicDecoderB) {
 				basicDecoderB->CalculateRC();
-				if (basicDecoderC != NULL) {
+				if (basicDecoderC) {
 					basicDecoderC->CalculateRC();
 				}
 			}
@@ -297,6 +277,7 @@ void PredecodeBlock::CalculateRC() {
 }
 
 void PredecodeBlock::CalculateLatency(double _rampInput) {
+	PROFILE(profile_predecode_latency);
 	if (!initialized) {
 		cout << "[Predecoder Block] Error: Require initialization first!" << endl;
 	} else if (numAddressBit == 0) {
@@ -309,15 +290,15 @@ void PredecodeBlock::CalculateLatency(double _rampInput) {
 		delayA1 = delayA2 = delayB = delayC = 0;
 		rampOutput = 0;
 		readLatency = writeLatency = 0;
-		if (basicDecoderA1 != NULL) {
+		if (basicDecoderA1) {
 			basicDecoderA1->CalculateLatency(rampInput);
 			delayA1 += basicDecoderA1->readLatency;
 			maxRampOutput = basicDecoderA1->rampOutput;
-			if (rowDecoderStage1A != NULL) {
+			if (rowDecoderStage1A) {
 				rowDecoderStage1A->CalculateLatency(basicDecoderA1->rampOutput);
 				delayA1 += rowDecoderStage1A->readLatency;
 				maxRampOutput = rowDecoderStage1A->rampOutput;
-				if (rowDecoderStage2 != NULL) {
+				if (rowDecoderStage2) {
 					rowDecoderStage2->CalculateLatency(rowDecoderStage1A->rampOutput);
 					delayA1 += rowDecoderStage2->readLatency;
 					maxRampOutput = rowDecoderStage2->rampOutput;
@@ -327,13 +308,13 @@ void PredecodeBlock::CalculateLatency(double _rampInput) {
 		rampOutput = max(rampOutput, maxRampOutput);
 		readLatency = max(readLatency, delayA1);
 		maxRampOutput = 0;
-		if (basicDecoderA2 != NULL) {
+		if (basicDecoderA2) {
 			basicDecoderA2->CalculateLatency(rampInput);
 			delayA2 += basicDecoderA1->readLatency;
 			rowDecoderStage1A->CalculateLatency(basicDecoderA2->rampOutput);
 			delayA2 += rowDecoderStage1A->readLatency;
 			maxRampOutput = rowDecoderStage1A->rampOutput;
-			if (rowDecoderStage2 != NULL) {
+			if (rowDecoderStage2) {
 				rowDecoderStage2->CalculateLatency(rowDecoderStage1A->rampOutput);
 				delayA2 += rowDecoderStage2->readLatency;
 				maxRampOutput = rowDecoderStage2->rampOutput;
@@ -342,7 +323,7 @@ void PredecodeBlock::CalculateLatency(double _rampInput) {
 		rampOutput = max(rampOutput, maxRampOutput);
 		readLatency = max(readLatency, delayA2);
 		maxRampOutput = 0;
-		if (basicDecoderB !=NULL) {
+		if (basicDecoderB) {
 			basicDecoderB->CalculateLatency(rampInput);
 			delayB += basicDecoderB->readLatency;
 			rowDecoderStage1B->CalculateLatency(basicDecoderB->rampOutput);
@@ -354,7 +335,7 @@ void PredecodeBlock::CalculateLatency(double _rampInput) {
 		rampOutput = max(rampOutput, maxRampOutput);
 		readLatency = max(readLatency, delayB);
 		maxRampOutput = 0;
-		if (basicDecoderC !=NULL) {
+		if (basicDecoderC) {
 			basicDecoderC->CalculateLatency(rampInput);
 			delayC += basicDecoderC->readLatency;
 			rowDecoderStage1C->CalculateLatency(basicDecoderC->rampOutput);
@@ -371,47 +352,48 @@ void PredecodeBlock::CalculateLatency(double _rampInput) {
 
 
 void PredecodeBlock::CalculatePower() {
+	PROFILE(profile_predecode_power);
 	if (!initialized) {
 		cout << "[Predecoder Block] Error: Require initialization first!" << endl;
 	} else if (numAddressBit == 0) {
 		leakage = readDynamicEnergy = writeDynamicEnergy = 0;
 	} else {
 		leakage = readDynamicEnergy = 0;
-		if (basicDecoderA1 != NULL) {
+		if (basicDecoderA1) {
 			basicDecoderA1->CalculatePower();
 			leakage += basicDecoderA1->leakage;
 			readDynamicEnergy += basicDecoderA1->readDynamicEnergy;
-			if (basicDecoderA2 != NULL) {
+			if (basicDecoderA2) {
 				basicDecoderA2->CalculatePower();
 				leakage += basicDecoderA2->leakage;
 				readDynamicEnergy += basicDecoderA2->readDynamicEnergy;
 			}
-			if (basicDecoderB != NULL) {
+			if (basicDecoderB) {
 				basicDecoderB->CalculatePower();
 				leakage += basicDecoderB->leakage;
 				readDynamicEnergy += basicDecoderB->readDynamicEnergy;
-				if (basicDecoderC != NULL) {
+				if (basicDecoderC) {
 					basicDecoderC->CalculatePower();
 					leakage += basicDecoderC->leakage;
 					readDynamicEnergy += basicDecoderC->readDynamicEnergy;
 				}
 			}
 		}
-		if (rowDecoderStage1A != NULL) {
+		if (rowDecoderStage1A) {
 			rowDecoderStage1A->CalculatePower();
 			leakage += rowDecoderStage1A->leakage;
 			readDynamicEnergy += rowDecoderStage1A->readDynamicEnergy;
-			if (rowDecoderStage1B != NULL) {
+			if (rowDecoderStage1B) {
 				rowDecoderStage1B->CalculatePower();
 				leakage += rowDecoderStage1B->leakage;
 				readDynamicEnergy += rowDecoderStage1B->readDynamicEnergy;
-				if (rowDecoderStage1C != NULL) {
+				if (rowDecoderStage1C) {
 					rowDecoderStage1C->CalculatePower();
 					leakage += rowDecoderStage1C->leakage;
 					readDynamicEnergy += rowDecoderStage1C->readDynamicEnergy;
 				}
 			}
-			if (rowDecoderStage2 != NULL) {
+			if (rowDecoderStage2) {
 				leakage += rowDecoderStage2->leakage;
 				readDynamicEnergy += rowDecoderStage2->readDynamicEnergy;
 			}
@@ -426,6 +408,8 @@ void PredecodeBlock::PrintProperty() {
 }
 
 PredecodeBlock & PredecodeBlock::operator=(const PredecodeBlock &rhs) {
+	if (this == &rhs)
+		return *this;
 	height = rhs.height;
 	width = rhs.width;
 	area = rhs.area;
@@ -440,9 +424,19 @@ PredecodeBlock & PredecodeBlock::operator=(const PredecodeBlock &rhs) {
 	cellReadEnergy = rhs.cellReadEnergy;
 	cellSetEnergy = rhs.cellSetEnergy;
 	cellResetEnergy = rhs.cellResetEnergy;
+	refreshLatency = rhs.refreshLatency;
+	refreshDynamicEnergy = rhs.refreshDynamicEnergy;
 	leakage = rhs.leakage;
 
 	initialized = rhs.initialized;
+	rowDecoderStage1A = rhs.rowDecoderStage1A;
+	rowDecoderStage1B = rhs.rowDecoderStage1B;
+	rowDecoderStage1C = rhs.rowDecoderStage1C;
+	rowDecoderStage2 = rhs.rowDecoderStage2;
+	basicDecoderA1 = rhs.basicDecoderA1;
+	basicDecoderA2 = rhs.basicDecoderA2;
+	basicDecoderB = rhs.basicDecoderB;
+	basicDecoderC = rhs.basicDecoderC;
 	numNandInputStage1A = rhs.numNandInputStage1A;
 	numNandInputStage1B = rhs.numNandInputStage1B;
 	numNandInputStage1C = rhs.numNandInputStage1C;
@@ -8,10 +8,13 @@
 #ifndef PREDECODEBLOCK_H_
 #define PREDECODEBLOCK_H_
 
+#include <optional>
 #include "FunctionUnit.h"
 #include "RowDecoder.h"
 #include "BasicDecoder.h"
 
+using namespace std;
+
 class PredecodeBlock: public FunctionUnit {
 public:
 	PredecodeBlock();
@@ -28,16 +31,17 @@ public:
 
 	/* Properties */
 	bool initialized;	/* Initialization flag */
-	RowDecoder * rowDecoderStage1A;
-	RowDecoder * rowDecoderStage1B;
-	RowDecoder * rowDecoderStage1C;
+	/* The decoder stages are stored inside the block, a stage that is not used is empty */
+	optional<RowDecoder> rowDecoderStage1A;
+	optional<RowDecoder> rowDecoderStage1B;
+	optional<RowDecoder> rowDecoderStage1C;
 	int numNandInputStage1A, numNandInputStage1B, numNandInputStage1C;
 	int numAddressBitStage1A, numAddressBitStage1B, numAddressBitStage1C;
-	RowDecoder * rowDecoderStage2;
-	BasicDecoder * basicDecoderA1;
-	BasicDecoder * basicDecoderA2;
-	BasicDecoder * basicDecoderB;
-	BasicDecoder * basicDecoderC;
+	optional<RowDecoder> rowDecoderStage2;
+	optional<BasicDecoder> basicDecoderA1;
+	optional<BasicDecoder> basicDecoderA2;
+	optional<BasicDecoder> basicDecoderB;
+	optional<BasicDecoder> basicDecoderC;
 	double capLoad;		/* Load capacitance Unit: F */
 	double resLoad;     /* Load resistance Unit: ohm */
 	int numAddressBit;   /* Number of Address Bits assigned to the block */
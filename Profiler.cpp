@@ -0,0 +1,150 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "Profiler.h"
+#include <atomic>
+#include <iomanip>
+
+bool Profiler::enabled = false;
+
+static atomic<long long> totalCall[num_profile_section];
+static atomic<long long> totalTime[num_profile_section];
+
+static const char *sectionNames[num_profile_section] = {
+	"nvsim: tag search",
+	"nvsim: data search",
+	"nvsim: wire refinement",
+	"nvsim: constraint pass",
+	"nvsim: pruning",
+	"nvsim: output",
+	"BankWithHtree::Initialize",
+	"BankWithHtree::CalculateArea",
+	"BankWithHtree::CalculateRC",
+	"BankWithHtree::CalculateLatencyAndPower",
+	"BankWithoutHtree::Initialize",
+	"BankWithoutHtree::CalculateArea",
+	"BankWithoutHtree::CalculateRC",
+	"BankWithoutHtree::CalculateLatencyAndPower",
+	"Mat::Initialize",
+	"Mat::CalculateArea",
+	"Mat::CalculateRC",
+	"Mat::CalculateLatency",
+	"Mat::CalculatePower",
+	"SubArray::Initialize",
+	"SubArray::CalculateArea",
+	"SubArray::CalculateLatency",
+	"SubArray::CalculatePower",
+	"PredecodeBlock::Initialize",
+	"PredecodeBlock::CalculateArea",
+	"PredecodeBlock::CalculateRC",
+	"PredecodeBlock::CalculateLatency",
+	"PredecodeBlock::CalculatePower",
+	"BasicDecoder::Initialize",
+	"BasicDecoder::CalculateArea",
+	"BasicDecoder::CalculateRC",
+	"BasicDecoder::CalculateLatency",
+	"BasicDecoder::CalculatePower",
+	"RowDecoder::Initialize",
+	"RowDecoder::CalculateArea",
+	"RowDecoder::CalculateRC",
+	"RowDecoder::CalculateLatency",
+	"RowDecoder::CalculatePower",
+	"Precharger::Initialize",
+	"Precharger::CalculateArea",
+	"Precharger::CalculateRC",
+	"Precharger::CalculateLatency",
+	"Precharger::CalculatePower",
+	"SenseAmp::Initialize",
+	"SenseAmp::CalculateArea",
+	"SenseAmp::CalculateRC",
+	"SenseAmp::CalculateLatency",
+	"SenseAmp::CalculatePower",
+	"Mux::Initialize",
+	"Mux::CalculateArea",
+	"Mux::CalculateRC",
+	"Mux::CalculateLatency",
+	"Mux::CalculatePower",
+	"OutputDriver::Initialize",
+	"OutputDriver::CalculateArea",
+	"OutputDriver::CalculateRC",
+	"OutputDriver::CalculateLatency",
+	"OutputDriver::CalculatePower",
+	"Comparator::Initialize",
+	"Comparator::CalculateArea",
+	"Comparator::CalculateRC",
+	"Comparator::CalculateLatency",
+	"Comparator::CalculatePower",
+	"TSV::Initialize",
+	"TSV::CalculateArea",
+	"TSV::CalculateLatencyAndPower",
+	"Wire::Initialize",
+	"Wire::CalculateLatencyAndPower",
+	"Wire::findOptimalRepeater",
+	"Wire::findPenalizedRepeater"
+};
+
+Profiler::Profiler() {
+	for (int i = 0; i < num_profile_section; i++) {
+		numCall[i] = 0;
+		totalNanoseconds[i] = 0;
+	}
+}
+
+Profiler::~Profiler() {
+	for (int i = 0; i < num_profile_section; i++) {
+		totalCall[i] += numCall[i];
+		totalTime[i] += totalNanoseconds[i];
+	}
+}
+
+Profiler & Profiler::ThreadProfiler() {
+	static thread_local Profiler profiler;
+	return profiler;
+}
+
+void Profiler::Collect(long long *calls, long long *nanoseconds) {
+	Profiler &profiler = ThreadProfiler();
+	for (int i = 0; i < num_profile_section; i++) {
+		calls[i] = totalCall[i] + profiler.numCall[i];
+		nanoseconds[i] = totalTime[i] + profiler.totalNanoseconds[i];
+	}
+}
+
+void Profiler::PrintStatistics(ostream &output) {
+	long long calls[num_profile_section], nanoseconds[num_profile_section];
+	Collect(calls, nanoseconds);
+	ios_base::fmtflags flags = output.flags();
+	streamsize precision = output.precision();
+	output << endl << "Profile (inclusive times of all the threads)" << endl;
+	output << left << setw(44) << "Section" << right << setw(14) << "Calls" << setw(14) << "Total (ms)"
+			<< setw(16) << "Average (ns)" << endl;
+	output << fixed << setprecision(1);
+	for (int i = 0; i < num_profile_section; i++) {
+		if (calls[i] == 0)
+			continue;
+		output << left << setw(44) << sectionNames[i] << right << setw(14) << calls[i]
+				<< setw(14) << nanoseconds[i] / 1e6 << setw(16) << (double)nanoseconds[i] / calls[i] << endl;
+	}
+	output.flags(flags);
+	output.precision(precision);
+}
+
+void Profiler::PrintJson(ostream &output) {
+	long long calls[num_profile_section], nanoseconds[num_profile_section];
+	Collect(calls, nanoseconds);
+	output << "{" << endl << "  \"sections\": [" << endl;
+	bool first = true;
+	for (int i = 0; i < num_profile_section; i++) {
+		if (calls[i] == 0)
+			continue;
+		if (!first)
+			output << "," << endl;
+		first = false;
+		output << "    {\"name\": \"" << sectionNames[i] << "\", \"calls\": " << calls[i]
+				<< ", \"nanoseconds\": " << nanoseconds[i] << "}";
+	}
+	output << endl << "  ]" << endl << "}" << endl;
+}
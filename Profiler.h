@@ -0,0 +1,144 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <ostream>
+#include <chrono>
+
+using namespace std;
+
+/* The code that is timed: the phases of nvsim() and the methods of the components.
+ * The times are inclusive, a method that calls another one is charged for it as well */
+enum ProfileSection {
+	profile_tag_search = 0,
+	profile_data_search,
+	profile_wire_refinement,
+	profile_constraint_pass,
+	profile_pruning,
+	profile_output,
+	profile_bank_htree_initialize,
+	profile_bank_htree_area,
+	profile_bank_htree_rc,
+	profile_bank_htree_latency_power,
+	profile_bank_initialize,
+	profile_bank_area,
+	profile_bank_rc,
+	profile_bank_latency_power,
+	profile_mat_initialize,
+	profile_mat_area,
+	profile_mat_rc,
+	profile_mat_latency,
+	profile_mat_power,
+	profile_subarray_initialize,
+	profile_subarray_area,
+	profile_subarray_latency,
+	profile_subarray_power,
+	profile_predecode_initialize,
+	profile_predecode_area,
+	profile_predecode_rc,
+	profile_predecode_latency,
+	profile_predecode_power,
+	profile_decoder_initialize,
+	profile_decoder_area,
+	profile_decoder_rc,
+	profile_decoder_latency,
+	profile_decoder_power,
+	profile_row_decoder_initialize,
+	profile_row_decoder_area,
+	profile_row_decoder_rc,
+	profile_row_decoder_latency,
+	profile_row_decoder_power,
+	profile_precharger_initialize,
+	profile_precharger_area,
+	profile_precharger_rc,
+	profile_precharger_latency,
+	profile_precharger_power,
+	profile_sense_amp_initialize,
+	profile_sense_amp_area,
+	profile_sense_amp_rc,
+	profile_sense_amp_latency,
+	profile_sense_amp_power,
+	profile_mux_initialize,
+	profile_mux_area,
+	profile_mux_rc,
+	profile_mux_latency,
+	profile_mux_power,
+	profile_output_driver_initialize,
+	profile_output_driver_area,
+	profile_output_driver_rc,
+	profile_output_driver_latency,
+	profile_output_driver_power,
+	profile_comparator_initialize,
+	profile_comparator_area,
+	profile_comparator_rc,
+	profile_comparator_latency,
+	profile_comparator_power,
+	profile_tsv_initialize,
+	profile_tsv_area,
+	profile_tsv_latency_power,
+	profile_wire_initialize,
+	profile_wire_latency_power,
+	profile_wire_optimal_repeater,
+	profile_wire_penalized_repeater,
+	num_profile_section
+};
+
+/* Call counts and times of the sections, one profiler per thread. The counts of a thread are added to the
+ * totals when the thread exits */
+class Profiler {
+public:
+	Profiler();
+	virtual ~Profiler();
+
+	/* Functions */
+	static Profiler & ThreadProfiler();	/* The profiler of the calling thread */
+	static void PrintStatistics(ostream &output);	/* Table of all the threads */
+	static void PrintJson(ostream &output);		/* The same in JSON */
+	void Add(ProfileSection section, long long nanoseconds) {
+		numCall[section]++;
+		totalNanoseconds[section] += nanoseconds;
+	}
+
+	/* Properties */
+	static bool enabled;	/* Set before any thread is started, nothing is timed if false */
+
+private:
+	static void Collect(long long *calls, long long *nanoseconds);
+
+	long long numCall[num_profile_section];
+	long long totalNanoseconds[num_profile_section];
+};
+
+/* Times the rest of the enclosing scope, or until Stop, if the profiler is enabled */
+class ProfileScope {
+public:
+	ProfileScope(ProfileSection _section) {
+		section = _section;
+		running = Profiler::enabled;
+		if (running)
+			start = chrono::steady_clock::now();
+	}
+	~ProfileScope() {
+		Stop();
+	}
+	void Stop() {
+		if (running)
+			Profiler::ThreadProfiler().Add(section,
+					chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+		running = false;
+	}
+
+private:
+	ProfileSection section;
+	bool running;
+	chrono::steady_clock::time_point start;
+};
+
+#define PROFILE(section) ProfileScope profileScope(section)
+
+#endif /* PROFILER_H_ */
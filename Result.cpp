@@ -752,7 +752,24 @@ void Result::printAsCache(Result &tagResult, CacheAccessMode cacheAccessMode) {
 	}
 }
 
-void Result::printToCsvFile(ofstream &outputFile) {
+void Result::printToCsvFile(ostream &outputFile) {
+	writeCsv(outputFile);
+}
+
+void Result::printToCsvFile(CsvWriter &outputFile) {
+	writeCsv(outputFile);
+}
+
+void Result::printAsCacheToCsvFile(Result &tagResult, CacheAccessMode cacheAccessMode, ostream &outputFile) {
+	writeCacheCsv(tagResult, cacheAccessMode, outputFile);
+}
+
+void Result::printAsCacheToCsvFile(Result &tagResult, CacheAccessMode cacheAccessMode, CsvWriter &outputFile) {
+	writeCacheCsv(tagResult, cacheAccessMode, outputFile);
+}
+
+template <class CsvOutput>
+void Result::writeCsv(CsvOutput &outputFile) {
 /*
 	outputFile << bank->readDynamicEnergy * 1e12 << ",";
 	outputFile << (bank->readDynamicEnergy - bank->mat.readDynamicEnergy
@@ -939,51 +956,53 @@ void Result::printToCsvFile(ofstream &outputFile) {
     }
 }
 
-void Result::printAsCacheToCsvFile(Result &tagResult, CacheAccessMode cacheAccessMode, ofstream &outputFile) {
+void Result::calculateCache(Result &tagResult, CacheAccessMode cacheAccessMode, CacheDesignRecord &record) {
+	if (cacheAccessMode == normal_access_mode) {
+		/* Calculate latencies */
+		record.missLatency = tagResult.bank->readLatency;		/* only the tag access latency */
+		record.hitLatency = MAX(tagResult.bank->readLatency, bank->mat.readLatency);	/* access tag and activate data row in parallel */
+		record.hitLatency += bank->mat.subarray.columnDecoderLatency;		/* add column decoder latency after hit signal arrives */
+		record.hitLatency += bank->readLatency - bank->mat.readLatency;	/* H-tree in and out latency */
+		record.writeLatency = MAX(tagResult.bank->writeLatency, bank->writeLatency);	/* Data and tag are written in parallel */
+		/* Calculate power */
+		record.missDynamicEnergy = tagResult.bank->readDynamicEnergy;	/* no matter what tag is always accessed */
+		record.missDynamicEnergy += bank->readDynamicEnergy;	/* data is also partially accessed, TO-DO: not accurate here */
+		record.hitDynamicEnergy = tagResult.bank->readDynamicEnergy + bank->readDynamicEnergy;
+		record.writeDynamicEnergy = tagResult.bank->writeDynamicEnergy + bank->writeDynamicEnergy;
+	} else if (cacheAccessMode == fast_access_mode) {
+		/* Calculate latencies */
+		record.missLatency = tagResult.bank->readLatency;
+		record.hitLatency = MAX(tagResult.bank->readLatency, bank->readLatency);
+		record.writeLatency = MAX(tagResult.bank->writeLatency, bank->writeLatency);
+		/* Calculate power */
+		record.missDynamicEnergy = tagResult.bank->readDynamicEnergy;	/* no matter what tag is always accessed */
+		record.missDynamicEnergy += bank->readDynamicEnergy;	/* data is also partially accessed, TO-DO: not accurate here */
+		record.hitDynamicEnergy = tagResult.bank->readDynamicEnergy + bank->readDynamicEnergy;
+		record.writeDynamicEnergy = tagResult.bank->writeDynamicEnergy + bank->writeDynamicEnergy;
+	} else {		/* sequential access */
+		/* Calculate latencies */
+		record.missLatency = tagResult.bank->readLatency;
+		record.hitLatency = tagResult.bank->readLatency + bank->readLatency;
+		record.writeLatency = MAX(tagResult.bank->writeLatency, bank->writeLatency);
+		/* Calculate power */
+		record.missDynamicEnergy = tagResult.bank->readDynamicEnergy;	/* no matter what tag is always accessed */
+		record.hitDynamicEnergy = tagResult.bank->readDynamicEnergy + bank->readDynamicEnergy;
+		record.writeDynamicEnergy = tagResult.bank->writeDynamicEnergy + bank->writeDynamicEnergy;
+	}
+	/* Calculate leakage */
+	record.leakage = tagResult.bank->leakage + bank->leakage;
+	/* Calculate area */
+	record.area = tagResult.bank->area + bank->area;	/* TO-DO: simply add them together here */
+}
+
+template <class CsvOutput>
+void Result::writeCacheCsv(Result &tagResult, CacheAccessMode cacheAccessMode, CsvOutput &outputFile) {
 	if (bank->memoryType != MemoryType::data || tagResult.bank->memoryType != tag) {
 		cout << "This is not a valid cache configuration." << endl;
 		return;
 	} else {
-		double cacheHitLatency, cacheMissLatency, cacheWriteLatency;
-		double cacheHitDynamicEnergy, cacheMissDynamicEnergy, cacheWriteDynamicEnergy;
-		double cacheLeakage;
-		double cacheArea;
-		if (cacheAccessMode == normal_access_mode) {
-			/* Calculate latencies */
-			cacheMissLatency = tagResult.bank->readLatency;		/* only the tag access latency */
-			cacheHitLatency = MAX(tagResult.bank->readLatency, bank->mat.readLatency);	/* access tag and activate data row in parallel */
-			cacheHitLatency += bank->mat.subarray.columnDecoderLatency;		/* add column decoder latency after hit signal arrives */
-			cacheHitLatency += bank->readLatency - bank->mat.readLatency;	/* H-tree in and out latency */
-			cacheWriteLatency = MAX(tagResult.bank->writeLatency, bank->writeLatency);	/* Data and tag are written in parallel */
-			/* Calculate power */
-			cacheMissDynamicEnergy = tagResult.bank->readDynamicEnergy;	/* no matter what tag is always accessed */
-			cacheMissDynamicEnergy += bank->readDynamicEnergy;	/* data is also partially accessed, TO-DO: not accurate here */
-			cacheHitDynamicEnergy = tagResult.bank->readDynamicEnergy + bank->readDynamicEnergy;
-			cacheWriteDynamicEnergy = tagResult.bank->writeDynamicEnergy + bank->writeDynamicEnergy;
-		} else if (cacheAccessMode == fast_access_mode) {
-			/* Calculate latencies */
-			cacheMissLatency = tagResult.bank->readLatency;
-			cacheHitLatency = MAX(tagResult.bank->readLatency, bank->readLatency);
-			cacheWriteLatency = MAX(tagResult.bank->writeLatency, bank->writeLatency);
-			/* Calculate power */
-			cacheMissDynamicEnergy = tagResult.bank->readDynamicEnergy;	/* no matter what tag is always accessed */
-			cacheMissDynamicEnergy += bank->readDynamicEnergy;	/* data is also partially accessed, TO-DO: not accurate here */
-			cacheHitDynamicEnergy = tagResult.bank->readDynamicEnergy + bank->readDynamicEnergy;
-			cacheWriteDynamicEnergy = tagResult.bank->writeDynamicEnergy + bank->writeDynamicEnergy;
-		} else {		/* sequential access */
-			/* Calculate latencies */
-			cacheMissLatency = tagResult.bank->readLatency;
-			cacheHitLatency = tagResult.bank->readLatency + bank->readLatency;
-			cacheWriteLatency = MAX(tagResult.bank->writeLatency, bank->writeLatency);
-			/* Calculate power */
-			cacheMissDynamicEnergy = tagResult.bank->readDynamicEnergy;	/* no matter what tag is always accessed */
-			cacheHitDynamicEnergy = tagResult.bank->readDynamicEnergy + bank->readDynamicEnergy;
-			cacheWriteDynamicEnergy = tagResult.bank->writeDynamicEnergy + bank->writeDynamicEnergy;
-		}
-		/* Calculate leakage */
-		cacheLeakage = tagResult.bank->leakage + bank->leakage;
-		/* Calculate area */
-		cacheArea = tagResult.bank->area + bank->area;	/* TO-DO: simply add them together here */
+		CacheDesignRecord cacheRecord;
+		calculateCache(tagResult, cacheAccessMode, cacheRecord);
 
 		/* start printing */
 		switch (cacheAccessMode) {
@@ -996,33 +1015,113 @@ void Result::printAsCacheToCsvFile(Result &tagResult, CacheAccessMode cacheAcces
 		default:	/* sequential */
 			outputFile << "Sequential" << ",";
 		}
-		outputFile << cacheArea * 1e6 << ",";
-		outputFile << cacheHitLatency * 1e9 << ",";
-		outputFile << cacheMissLatency * 1e9 << ",";
-		outputFile << cacheWriteLatency * 1e9 << ",";
+		outputFile << cacheRecord.area * 1e6 << ",";
+		outputFile << cacheRecord.hitLatency * 1e9 << ",";
+		outputFile << cacheRecord.missLatency * 1e9 << ",";
+		outputFile << cacheRecord.writeLatency * 1e9 << ",";
         if (cell->memCellType == eDRAM) {
             outputFile << MAX(tagResult.bank->refreshLatency, bank->refreshLatency) * 1e9 << ",";
         } else {
             outputFile << "0,";
         }
-		outputFile << cacheHitDynamicEnergy * 1e9 << ",";
-		outputFile << cacheMissDynamicEnergy * 1e9 << ",";
-		outputFile << cacheWriteDynamicEnergy * 1e9 << ",";
+		outputFile << cacheRecord.hitDynamicEnergy * 1e9 << ",";
+		outputFile << cacheRecord.missDynamicEnergy * 1e9 << ",";
+		outputFile << cacheRecord.writeDynamicEnergy * 1e9 << ",";
         if (cell->memCellType == eDRAM) {
             outputFile << (tagResult.bank->refreshDynamicEnergy + bank->refreshDynamicEnergy) * 1e9 << ",";
         } else {
             outputFile << "0,";
         }
-		outputFile << cacheLeakage * 1e3 << ",";
+		outputFile << cacheRecord.leakage * 1e3 << ",";
         if (cell->memCellType == eDRAM) {
             outputFile << TO_WATT(bank->refreshDynamicEnergy / (cell->retentionTime)) << ",";
         } else {
             outputFile << "0,";
         }
-		printToCsvFile(outputFile);
-		tagResult.printToCsvFile(outputFile);
+		writeCsv(outputFile);
+		tagResult.writeCsv(outputFile);
         outputFile << bank->mat.subarray.leakage + tagResult.bank->mat.subarray.leakage << ",";
         outputFile << (bank->mat.subarray.area + tagResult.bank->mat.subarray.area) * 1e6 << ",";
-		outputFile << endl;
+		outputFile << "\n";
+	}
+}
+
+void Result::fillRecord(DesignRecord &record) {
+	record.numRowMat = bank->numRowMat;
+	record.numColumnMat = bank->numColumnMat;
+	record.stackedDieCount = bank->stackedDieCount;
+	record.numActiveMatPerColumn = bank->numActiveMatPerColumn;
+	record.numActiveMatPerRow = bank->numActiveMatPerRow;
+	record.numRowSubarray = bank->numRowSubarray;
+	record.numColumnSubarray = bank->numColumnSubarray;
+	record.numActiveSubarrayPerColumn = bank->numActiveSubarrayPerColumn;
+	record.numActiveSubarrayPerRow = bank->numActiveSubarrayPerRow;
+	record.numRowPerSubarray = bank->mat.subarray.numRow;
+	record.numColumnPerSubarray = bank->mat.subarray.numColumn;
+	record.muxSenseAmp = bank->muxSenseAmp;
+	record.muxOutputLev1 = bank->muxOutputLev1;
+	record.muxOutputLev2 = bank->muxOutputLev2;
+	record.numRowPerSet = (inputParameter->designTarget == cache) ? bank->numRowPerSet : -1;
+	record.localWireType = localWire->wireType;
+	record.localWireRepeaterType = localWire->wireRepeaterType;
+	record.localWireLowSwing = localWire->isLowSwing;
+	record.globalWireType = globalWire->wireType;
+	record.globalWireRepeaterType = globalWire->wireRepeaterType;
+	record.globalWireLowSwing = globalWire->isLowSwing;
+	record.areaOptimizationLevel = bank->areaOptimizationLevel;
+	record.height = bank->height;
+	record.width = bank->width;
+	record.area = bank->area;
+	record.matHeight = bank->mat.height;
+	record.matWidth = bank->mat.width;
+	record.matArea = bank->mat.area;
+	record.subarrayHeight = bank->mat.subarray.height;
+	record.subarrayWidth = bank->mat.subarray.width;
+	record.subarrayArea = bank->mat.subarray.area;
+	record.areaEfficiency = cell->area * tech->featureSize * tech->featureSize * bank->capacity / bank->area * 100;
+	record.readLatency = bank->readLatency;
+	record.writeLatency = bank->writeLatency;
+	record.readDynamicEnergy = bank->readDynamicEnergy;
+	record.writeDynamicEnergy = bank->writeDynamicEnergy;
+	record.leakage = bank->leakage;
+	if (cell->memCellType == eDRAM) {
+		record.refreshLatency = bank->refreshLatency;
+		record.refreshDynamicEnergy = bank->refreshDynamicEnergy;
+		record.refreshPower = bank->refreshDynamicEnergy / (cell->retentionTime);
+	} else {
+		record.refreshLatency = 0;
+		record.refreshDynamicEnergy = 0;
+		record.refreshPower = 0;
+	}
+}
+
+void Result::printToBinaryFile(CsvWriter &outputFile) {
+	DesignRecord record;
+	fillRecord(record);
+	outputFile.Write((const char *)&record, sizeof(record));
+}
+
+void Result::printAsCacheToBinaryFile(Result &tagResult, CacheAccessMode cacheAccessMode, CsvWriter &outputFile) {
+	if (bank->memoryType != MemoryType::data || tagResult.bank->memoryType != tag) {
+		cout << "This is not a valid cache configuration." << endl;
+		return;
+	}
+	CacheDesignRecord record;
+	calculateCache(tagResult, cacheAccessMode, record);
+	record.cacheAccessMode = cacheAccessMode;
+	record.tagOptimizationTarget = tagResult.optimizationTarget;
+	if (cell->memCellType == eDRAM) {
+		record.refreshLatency = MAX(tagResult.bank->refreshLatency, bank->refreshLatency);
+		record.refreshDynamicEnergy = tagResult.bank->refreshDynamicEnergy + bank->refreshDynamicEnergy;
+		record.refreshPower = bank->refreshDynamicEnergy / (cell->retentionTime);
+	} else {
+		record.refreshLatency = 0;
+		record.refreshDynamicEnergy = 0;
+		record.refreshPower = 0;
 	}
+	record.subarrayLeakage = bank->mat.subarray.leakage + tagResult.bank->mat.subarray.leakage;
+	record.subarrayArea = bank->mat.subarray.area + tagResult.bank->mat.subarray.area;
+	fillRecord(record.data);
+	tagResult.fillRecord(record.tag);
+	outputFile.Write((const char *)&record, sizeof(record));
 }
@@ -12,6 +12,8 @@
 #include "BankWithHtree.h"
 #include "BankWithoutHtree.h"
 #include "Wire.h"
+#include "CsvWriter.h"
+#include "ColumnFile.h"
 
 class Result {
 public:
@@ -23,8 +25,12 @@ public:
 	void printAsCache(Result &tagBank, CacheAccessMode cacheAccessMode);
 	void reset();
     bool nearReference(double reference, double measured);
-	void printToCsvFile(ofstream &outputFile);
-	void printAsCacheToCsvFile(Result &tagBank, CacheAccessMode cacheAccessMode, ofstream &outputFile);
+	void printToCsvFile(ostream &outputFile);
+	void printToCsvFile(CsvWriter &outputFile);
+	void printAsCacheToCsvFile(Result &tagBank, CacheAccessMode cacheAccessMode, ostream &outputFile);
+	void printAsCacheToCsvFile(Result &tagBank, CacheAccessMode cacheAccessMode, CsvWriter &outputFile);
+	void printToBinaryFile(CsvWriter &outputFile);	/* A DesignRecord, see ColumnFile.h */
+	void printAsCacheToBinaryFile(Result &tagBank, CacheAccessMode cacheAccessMode, CsvWriter &outputFile);	/* A CacheDesignRecord */
 	bool compareAndUpdate(Result &newResult);
     string printOptimizationTarget();
 
@@ -43,6 +49,13 @@ public:
 	double limitArea;					/* The maximum allowable area, Unit: m^2 */
 	double limitLeakage;				/* The maximum allowable leakage power, Unit: W */
     MemCell *cellTech;
+
+private:
+	/* The csv rows are written the same way to a stream and to a CsvWriter */
+	template <class CsvOutput> void writeCsv(CsvOutput &outputFile);
+	template <class CsvOutput> void writeCacheCsv(Result &tagResult, CacheAccessMode cacheAccessMode, CsvOutput &outputFile);
+	void calculateCache(Result &tagResult, CacheAccessMode cacheAccessMode, CacheDesignRecord &record);	/* The cache metrics only */
+	void fillRecord(DesignRecord &record);
 };
 
 #endif /* RESULT_H_ */
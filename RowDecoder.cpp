@@ -9,6 +9,7 @@
 #include "RowDecoder.h"
 #include "formula.h"
 #include "global.h"
+#include "Profiler.h"
 
 RowDecoder::RowDecoder() : FunctionUnit(){
 	// TODO Auto-generated constructor stub
@@ -22,6 +23,7 @@ RowDecoder::~RowDecoder() {
 
 void RowDecoder::Initialize(int _numRow, double _capLoad, double _resLoad,
 		bool _multipleRowPerSet, BufferDesignTarget _areaOptimizationLevel, double _minDriverCurrent) {
+	PROFILE(profile_row_decoder_initialize);
 	if (initialized)
 		cout << "[Row Decoder] Warning: Already initialized!" << endl;
 
@@ -75,6 +77,7 @@ void RowDecoder::Initialize(int _numRow, double _capLoad, double _resLoad,
 }
 
 void RowDecoder::CalculateArea() {
+	PROFILE(profile_row_decoder_area);
 	if (!initialized) {
 		cout << "[Row Decoder Area] Error: Require initialization first!" << endl;
 	} else {
@@ -94,6 +97,7 @@ void RowDecoder::CalculateArea() {
 }
 
 void RowDecoder::CalculateRC() {
+	PROFILE(profile_row_decoder_rc);
 	if (!initialized) {
 		cout << "[Row Decoder RC] Error: Require initialization first!" << endl;
 	} else {
@@ -107,6 +111,7 @@ void RowDecoder::CalculateRC() {
 }
 
 void RowDecoder::CalculateLatency(double _rampInput) {
+	PROFILE(profile_row_decoder_latency);
 	if (!initialized) {
 		cout << "[Row Decoder Latency] Error: Require initialization first!" << endl;
 	} else {
@@ -140,6 +145,7 @@ void RowDecoder::CalculateLatency(double _rampInput) {
 }
 
 void RowDecoder::CalculatePower() {
+	PROFILE(profile_row_decoder_power);
 	if (!initialized) {
 		cout << "[Row Decoder Power] Error: Require initialization first!" << endl;
 	} else {
@@ -184,6 +190,8 @@ RowDecoder & RowDecoder::operator=(const RowDecoder &rhs) {
 	setLatency = rhs.setLatency;
 	resetDynamicEnergy = rhs.resetDynamicEnergy;
 	setDynamicEnergy = rhs.setDynamicEnergy;
+	refreshLatency = rhs.refreshLatency;
+	refreshDynamicEnergy = rhs.refreshDynamicEnergy;
 	cellReadEnergy = rhs.cellReadEnergy;
 	cellSetEnergy = rhs.cellSetEnergy;
 	cellResetEnergy = rhs.cellResetEnergy;
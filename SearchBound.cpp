@@ -0,0 +1,219 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "SearchBound.h"
+#include "BankPool.h"
+#include "global.h"
+#include "constant.h"
+#include <math.h>
+
+bool BoundSignature::operator<(const BoundSignature &rhs) const {
+	if (numAddressBit != rhs.numAddressBit)
+		return numAddressBit < rhs.numAddressBit;
+	if (numDataBit != rhs.numDataBit)
+		return numDataBit < rhs.numDataBit;
+	if (numWay != rhs.numWay)
+		return numWay < rhs.numWay;
+	if (numActiveMat != rhs.numActiveMat)
+		return numActiveMat < rhs.numActiveMat;
+	return stackedDieCount < rhs.stackedDieCount;
+}
+
+SearchBound::SearchBound() {
+	enabled = false;
+	optimizationTarget = full_exploration;
+	capacity = 0;
+	blockSize = 0;
+	associativity = 1;
+	partitionGranularity = 0;
+	cellArea = 0;
+	beta = 1;
+	boundWire = false;
+	unitDelay = quadraticDelay = 0;
+	unitDynamicEnergy = unitLeakage = 0;
+	recording = false;
+}
+
+SearchBound::~SearchBound() {
+	// TODO Auto-generated destructor stub
+}
+
+void SearchBound::Initialize(OptimizationTarget _optimizationTarget, long long _capacity, long _blockSize,
+		int _associativity, int _partitionGranularity) {
+	optimizationTarget = _optimizationTarget;
+	capacity = _capacity;
+	blockSize = _blockSize;
+	associativity = _associativity;
+	partitionGranularity = _partitionGranularity;
+	cellArea = cell->widthInFeatureSize * cell->heightInFeatureSize * devtech->featureSize * devtech->featureSize;
+	records.clear();
+	recording = false;
+
+	/* BankWithoutHtree takes some of its routing latency back from the mat, so it is not bounded */
+	enabled = inputParameter->routingMode == h_tree && optimizationTarget < full_exploration;
+
+	beta = 1;
+	if (inputParameter->designTarget == cache && inputParameter->cacheAccessMode == fast_access_mode)
+		beta = inputParameter->associativity;
+
+	/* Same as Wire::CalculateLatencyAndPower */
+	boundWire = !globalWire->isLowSwing;
+	unitDelay = quadraticDelay = 0;
+	if (globalWire->wireRepeaterType == repeated_none) {
+		quadraticDelay = 2.3 * globalWire->resWirePerUnit * globalWire->capWirePerUnit / 2;
+		unitDynamicEnergy = globalWire->capWirePerUnit * tech->vdd * tech->vdd;
+		unitLeakage = 0;
+	} else {
+		unitDelay = globalWire->getRepeatedWireUnitDelay();
+		unitDynamicEnergy = globalWire->getRepeatedWireUnitDynamicEnergy();
+		unitLeakage = globalWire->getRepeatedWireUnitLeakage();
+	}
+}
+
+void SearchBound::BoundWire(int numRowMat, int numColumnMat, int stackedDieCount, double *wireLength, double *wireLatency) const {
+	int levelHorizontal = (int)(log2(numColumnMat)+0.1);
+	int levelVertical = (int)(log2(numRowMat)+0.1);
+	*wireLength = *wireLatency = 0;
+	if (!boundWire || levelHorizontal == 0 || levelVertical == 0)
+		return;	/* The mats can be as long as needed in the direction without wires */
+
+	/* The cells of a die are spread over the mats */
+	double matArea = (double)capacity / stackedDieCount / numRowMat / numColumnMat * cellArea;
+
+	/* The H-tree wires start from the mat width and half the mat height, and double at every level.
+	 * For a * width + b * height with width * height >= matArea, the minimum is 2 * sqrt(a * b * matArea) */
+	double sumHorizontal = pow(2, levelHorizontal) - 1;
+	double sumVertical = (pow(2, levelVertical) - 1) / 2;
+	*wireLength = 2 * sqrt(sumHorizontal * sumVertical * matArea);	/* From the bank edge to a mat */
+	if (quadraticDelay > 0) {
+		double sumSquareHorizontal = (pow(4, levelHorizontal) - 1) / 3;
+		double sumSquareVertical = (pow(4, levelVertical) - 1) / 12;
+		*wireLatency = quadraticDelay * 2 * sqrt(sumSquareHorizontal * sumSquareVertical) * matArea;
+	} else {
+		*wireLatency = unitDelay * *wireLength;
+	}
+}
+
+double SearchBound::MatMetric(const Mat &mat) const {
+	switch (optimizationTarget) {
+	case read_latency_optimized:
+		return mat.readLatency;
+	case write_latency_optimized:
+		return mat.writeLatency;
+	case read_energy_optimized:
+		return mat.readDynamicEnergy;
+	case write_energy_optimized:
+		return mat.writeDynamicEnergy;
+	case read_edp_optimized:
+		return mat.readLatency * mat.readDynamicEnergy;
+	case write_edp_optimized:
+		return mat.writeLatency * mat.writeDynamicEnergy;
+	case leakage_optimized:
+		return mat.leakage;
+	default:	/* area */
+		return mat.area;
+	}
+}
+
+bool SearchBound::Prune(const Result &bestResult, int numRowMat, int numColumnMat, int stackedDieCount,
+		int numActiveMatPerRow, int numActiveMatPerColumn) {
+	recording = false;
+	if (!enabled)
+		return false;
+
+	/* Route a bank of the organization to find its signature, the mat-level parameters do not matter */
+	Bank *probe = BankPool::ThreadPool().Acquire();
+	probe->Initialize(numRowMat, numColumnMat, capacity, blockSize, associativity, 1, numActiveMatPerRow, numActiveMatPerColumn,
+			inputParameter->minMuxSenseAmp, inputParameter->internalSensing, inputParameter->minMuxOutputLev1, inputParameter->minMuxOutputLev2,
+			inputParameter->minNumRowSubarray, inputParameter->minNumColumnSubarray, 1, 1,
+			(BufferDesignTarget)inputParameter->minAreaOptimizationLevel, MemoryType::data, stackedDieCount, partitionGranularity,
+			inputParameter->monolithicStackCount);
+	bool routed = probe->mat.initialized;
+	BoundSignature signature;
+	signature.numAddressBit = probe->mat.numAddressBit;
+	signature.numDataBit = probe->mat.numDataBit;
+	signature.numWay = probe->mat.numWay;
+	signature.numActiveMat = numActiveMatPerRow * numActiveMatPerColumn;
+	signature.stackedDieCount = stackedDieCount;
+	BankPool::ThreadPool().Release(probe);
+	if (!routed)
+		return true;	/* The H-tree can not be routed whatever the mats are */
+
+	map<BoundSignature, BoundRecord>::const_iterator record = records.find(signature);
+	if (record == records.end()) {
+		recording = true;
+		currentSignature = signature;
+		currentRecord.valid = false;
+		currentRecord.minMatMetric = invalid_value;
+		return false;
+	}
+	if (!record->second.valid)
+		return true;	/* None of the mats is valid */
+
+	double wireLength, wireLatency;
+	BoundWire(numRowMat, numColumnMat, stackedDieCount, &wireLength, &wireLatency);
+	double minMatMetric = record->second.minMatMetric;
+	int numActiveMat = signature.numActiveMat;
+	double bound, best;
+	switch (optimizationTarget) {
+	case read_latency_optimized:
+		bound = minMatMetric + wireLatency * 2;		/* in/out */
+		best = bestResult.bank->readLatency;
+		break;
+	case write_latency_optimized:
+		bound = minMatMetric + wireLatency;
+		best = bestResult.bank->writeLatency;
+		break;
+	case read_energy_optimized:
+		bound = minMatMetric * numActiveMat + unitDynamicEnergy * wireLength;
+		best = bestResult.bank->readDynamicEnergy;
+		break;
+	case write_energy_optimized:
+		bound = minMatMetric * numActiveMat + unitDynamicEnergy * wireLength / beta;
+		best = bestResult.bank->writeDynamicEnergy;
+		break;
+	case read_edp_optimized:
+		bound = minMatMetric * numActiveMat + wireLatency * 2 * unitDynamicEnergy * wireLength;
+		best = bestResult.bank->readLatency * bestResult.bank->readDynamicEnergy;
+		break;
+	case write_edp_optimized:
+		bound = minMatMetric * numActiveMat + wireLatency * unitDynamicEnergy * wireLength / beta;
+		best = bestResult.bank->writeLatency * bestResult.bank->writeDynamicEnergy;
+		break;
+	case leakage_optimized:
+		bound = (minMatMetric * numRowMat * numColumnMat + unitLeakage * wireLength) * (stackedDieCount > 1 ? stackedDieCount : 1);
+		best = bestResult.bank->leakage;
+		break;
+	default:	/* area */
+		bound = minMatMetric * numRowMat * numColumnMat;
+		best = bestResult.bank->area;
+	}
+	/* A design that is only as good as the best one does not replace it either, but the parallel search
+	 * merges the bests in the serial order, so only the designs that are strictly worse are skipped.
+	 * The margin covers the rounding */
+	return bound * (1 - 1e-9) > best;
+}
+
+void SearchBound::Record(Bank &bank) {
+	if (!recording || !bank.mat.initialized || bank.mat.invalid)
+		return;
+	if (bank.invalid) {
+		/* The bank is rejected after its mat, which is still a mat of the signature */
+		bank.mat.CalculateRC();
+		bank.mat.CalculateLatency(infinite_ramp);
+		bank.mat.CalculatePower();
+	}
+	double metric = MatMetric(bank.mat);
+	if (!currentRecord.valid || metric < currentRecord.minMatMetric)
+		currentRecord.minMatMetric = metric;
+	currentRecord.valid = true;
+}
+
+void SearchBound::FinishOrganization() {
+	if (recording)
+		records[currentSignature] = currentRecord;
+	recording = false;
+}
@@ -0,0 +1,83 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef SEARCHBOUND_H_
+#define SEARCHBOUND_H_
+
+#include <map>
+#include "Result.h"
+#include "Bank.h"
+#include "typedef.h"
+
+using namespace std;
+
+/* What the mats of a bank organization depend on, besides the mat-level parameters. The H-tree routing
+ * of a bank hands the same address bits, data bits and ways to its mats for many organizations, and the
+ * organizations with the same signature go through exactly the same mats in their mat-level search */
+struct BoundSignature {
+	int numAddressBit;
+	long numDataBit;
+	int numWay;
+	int numActiveMat;		/* The partitioning check of the mat-level search depends on it */
+	int stackedDieCount;
+
+	bool operator<(const BoundSignature &rhs) const;
+};
+
+/* Lower bounds for the branch-and-bound search of a single optimization target, H-tree banks only.
+ * The bound of a bank organization holds for all its mat-level designs, so its whole mat-level search
+ * is skipped when the bound is worse than the best result so far. The bound is made of:
+ *  - the best mat of the first organization with the same signature that was searched in full,
+ *    since the bank only adds its routing to the mat (scaled by the active mats, or all the mats)
+ *  - the H-tree wires, which can not be shorter than what the cell area of the mats allows */
+class SearchBound {
+public:
+	SearchBound();
+	virtual ~SearchBound();
+
+	/* Functions */
+	void Initialize(OptimizationTarget _optimizationTarget, long long _capacity, long _blockSize,
+			int _associativity, int _partitionGranularity);	/* With the current global wire */
+	bool Prune(const Result &bestResult, int numRowMat, int numColumnMat, int stackedDieCount,
+			int numActiveMatPerRow, int numActiveMatPerColumn);	/* Also starts the organization if it is not pruned */
+	void Record(Bank &bank);		/* Every design of the organization, valid or not */
+	void FinishOrganization();		/* After the whole mat-level search */
+
+	/* Properties */
+	bool enabled;		/* Whether the target and the routing mode can be bounded */
+	OptimizationTarget optimizationTarget;
+
+private:
+	/* The best mat of the organizations with a signature, in the target metric */
+	struct BoundRecord {
+		bool valid;				/* Whether any mat is valid, otherwise no design of the signature is */
+		double minMatMetric;
+	};
+
+	double MatMetric(const Mat &mat) const;
+	void BoundWire(int numRowMat, int numColumnMat, int stackedDieCount, double *wireLength, double *wireLatency) const;
+
+	long long capacity;		/* Unit: bit */
+	long blockSize;			/* Unit: bit */
+	int associativity;
+	int partitionGranularity;
+	double cellArea;		/* Unit: m^2 */
+	int beta;				/* Only 1/beta of the H-tree wires are written, see BankWithHtree */
+	bool boundWire;			/* The low-swing wire latency does not simply grow with the length */
+
+	/* The latency of a global wire is unitDelay * length for a repeated wire, and quadraticDelay * length^2 for an unrepeated one */
+	double unitDelay;
+	double quadraticDelay;
+	double unitDynamicEnergy;
+	double unitLeakage;
+
+	map<BoundSignature, BoundRecord> records;	/* The signatures that were searched in full */
+	bool recording;				/* Whether the current organization is searched to make a record */
+	BoundSignature currentSignature;
+	BoundRecord currentRecord;
+};
+
+#endif /* SEARCHBOUND_H_ */
@@ -9,6 +9,7 @@
 #include "SenseAmp.h"
 #include "formula.h"
 #include "global.h"
+#include "Profiler.h"
 
 SenseAmp::SenseAmp() {
 	// TODO Auto-generated constructor stub
@@ -21,6 +22,7 @@ SenseAmp::~SenseAmp() {
 }
 
 void SenseAmp::Initialize(long long _numColumn, bool _currentSense, double _senseVoltage, double _pitchSenseAmp) {
+	PROFILE(profile_sense_amp_initialize);
 	if (initialized)
 		cout << "[Sense Amp] Warning: Already initialized!" << endl;
 
@@ -38,6 +40,7 @@ void SenseAmp::Initialize(long long _numColumn, bool _currentSense, double _sens
 }
 
 void SenseAmp::CalculateArea() {
+	PROFILE(profile_sense_amp_area);
 	if (!initialized) {
 		cout << "[Sense Amp] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -86,6 +89,7 @@ void SenseAmp::CalculateArea() {
 }
 
 void SenseAmp::CalculateRC() {
+	PROFILE(profile_sense_amp_rc);
 	if (!initialized) {
 		cout << "[Sense Amp] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -100,6 +104,7 @@ void SenseAmp::CalculateRC() {
 }
 
 void SenseAmp::CalculateLatency(double _rampInput) {	/* _rampInput is actually no use in SenseAmp */
+	PROFILE(profile_sense_amp_latency);
 	if (!initialized) {
 		cout << "[Sense Amp] Error: Require initialization first!" << endl;
 	} else {
@@ -132,6 +137,7 @@ void SenseAmp::CalculateLatency(double _rampInput) {	/* _rampInput is actually n
 }
 
 void SenseAmp::CalculatePower() {
+	PROFILE(profile_sense_amp_power);
 	if (!initialized) {
 		cout << "[Sense Amp] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -9,13 +9,17 @@
 #include "SubArray.h"
 #include "formula.h"
 #include "global.h"
+#include "EvalContext.h"
 #include "constant.h"
+#include "Profiler.h"
 #include <math.h>
 
 SubArray::SubArray() {
 	// TODO Auto-generated constructor stub
 	initialized = false;
 	invalid = false;
+	context = NULL;
+	kernel = NULL;
 }
 
 SubArray::~SubArray() {
@@ -24,7 +28,10 @@ SubArray::~SubArray() {
 
 void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipleRowPerSet, bool _split,
 		int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
-		BufferDesignTarget _areaOptimizationLevel, int _num3DLevels) {
+		BufferDesignTarget _areaOptimizationLevel, int _num3DLevels, EvalContext *_context) {
+	PROFILE(profile_subarray_initialize);
+	context = _context;
+	EvalContextScope scope(context);
 	if (initialized)
 		cout << "[Subarray] Warning: Already initialized!" << endl;
 
@@ -39,6 +46,13 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 	areaOptimizationLevel = _areaOptimizationLevel;
     num3DLevels = _num3DLevels;
 
+	/* The rest only depends on the cell type through the kernel */
+	kernel = &kernels[cell->memCellType];
+	(this->*kernel->initialize)();
+}
+
+template <MemCellType cellType>
+void SubArray::InitializeKernel() {
 	double maxWordlineCurrent = 0;
 	double maxBitlineCurrent = 0;
 
@@ -52,7 +66,7 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 		}
 	}
 
-	if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+	if constexpr (cellType == DRAM || cellType == eDRAM) {
 		if (muxSenseAmp > 1) {
 			/* DRAM does not allow muxed bitline because of its destructive readout */
 			invalid = true;
@@ -61,7 +75,7 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 		}
 	}
 
-	if (cell->memCellType == SLCNAND) {
+	if constexpr (cellType == SLCNAND) {
 		if (numRow < inputParameter->flashBlockSize / inputParameter->pageSize) {
 			/* SLC NAND does not have enough rows to hold the page count */
 			invalid = true;
@@ -76,7 +90,7 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 		}
 	}
 
-	if (cell->memCellType == memristor || cell->memCellType == FBRAM) {
+	if constexpr (cellType == memristor || cellType == FBRAM) {
 		if (internalSenseAmp && muxSenseAmp < 2) {
 			/* There is no way to put the sense amp */
 			invalid = true;
@@ -85,7 +99,7 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 		}
 	}
 
-	if (cell->memCellType == FBRAM) {
+	if constexpr (cellType == FBRAM) {
 		if (cell->resistanceOff / cell->resistanceOn < numRow / BITLINE_LEAKAGE_TOLERANCE) {
 			/* bitline too long */
 			invalid = true;
@@ -95,7 +109,7 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 		maxBitlineCurrent = MAX(cell->resetCurrent, cell->setCurrent) + cell->leakageCurrentAccessDevice * (numRow - 1);
 	}
 
-	if (cell->memCellType == MRAM || cell->memCellType == PCRAM || cell->memCellType == memristor) {
+	if constexpr (cellType == MRAM || cellType == PCRAM || cellType == memristor) {
 		if (cell->accessType == CMOS_access){
 			if (tech->currentOnNmos[inputParameter->temperature - 300]
 									/ tech->currentOffNmos[inputParameter->temperature - 300] < numRow / BITLINE_LEAKAGE_TOLERANCE) {
@@ -169,15 +183,15 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 	}
 
 	if (internalSenseAmp) {
-		if (cell->memCellType == SRAM || cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+		if constexpr (cellType == SRAM || cellType == DRAM || cellType == eDRAM) {
 			/* SRAM, DRAM, and eDRAM all use voltage sensing */
 			voltageSense = true;
-		} else if (cell->memCellType == MRAM || cell->memCellType == PCRAM || cell->memCellType == memristor || cell->memCellType == FBRAM) {
+		} else if constexpr (cellType == MRAM || cellType == PCRAM || cellType == memristor || cellType == FBRAM) {
 			voltageSense = cell->readMode;
 		} else {/* NAND flash */
 			voltageSense = true;
 		}
-	} else if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+	} else if constexpr (cellType == DRAM || cellType == eDRAM) {
 		cout << "[Subarray] Error: DRAM does not support external sense amplifiers!" << endl;
 		exit(-1);
 	}
@@ -207,7 +221,7 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 		lenWordline += ((numColumn - 1) / cell->stitching + 1) * STITCHING_OVERHEAD * devtech->featureSize;
 	}
 	/* Add select transistors into the length calculation */
-	if (cell->memCellType == SLCNAND) {
+	if constexpr (cellType == SLCNAND) {
 		int pageCount = inputParameter->flashBlockSize / inputParameter->pageSize;
 		/* Two select transistor including contacts have total length of 5F */
 		lenBitline += (numRow / pageCount) * 5 * tech->featureSize;
@@ -224,14 +238,14 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
         capMuxLoad = CalculateGateCap(minBitlineMuxWidth, *tech) * numColumn;
         capMuxLoad += capWordline;
 
-	if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+	if constexpr (cellType == DRAM || cellType == eDRAM) {
 		senseVoltage = devtech->vdd / 2 * cell->capDRAMCell / (cell->capDRAMCell + capBitline);
 		if (senseVoltage < cell->minSenseVoltage) {		/* Bitline is too long */
 			invalid = true;
 			initialized = true;
 			return;
 		}
-	} else if (cell->memCellType == SLCNAND){
+	} else if constexpr (cellType == SLCNAND){
 		/* suppose the reference voltage is 0.5Vdd, the initial bitline voltage is 0.6Vdd
 		 * if the bitline drops to 0.4Vdd, the senseamp can tell which data is stored */
 		senseVoltage = MAX(cell->minSenseVoltage, 0.2 * tech->vdd);
@@ -241,21 +255,21 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 	}
 
 	/* Add transistor resistance/capacitance */
-	if (cell->memCellType == SRAM) {
+	if constexpr (cellType == SRAM) {
 		/* SRAM has two access transistors */
 		resCellAccess = CalculateOnResistance(cell->widthAccessCMOS * tech->featureSize, NMOS, inputParameter->temperature, *tech);
 		capCellAccess = CalculateDrainCap(cell->widthAccessCMOS * tech->featureSize, NMOS, cell->widthInFeatureSize * tech->featureSize, *tech);
 		capWordline += 2 * CalculateGateCap(cell->widthAccessCMOS * tech->featureSize, *tech) * numColumn;
 		capBitline  += capCellAccess * numRow / 2;	/* Due to shared contact */
 		voltagePrecharge = tech->vdd / 2;	/* SRAM read voltage is always half of vdd */
-	} else if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+	} else if constexpr (cellType == DRAM || cellType == eDRAM) {
 		/* DRAM and eDRAM only has one access transistors */
 		resCellAccess = CalculateOnResistance(cell->widthAccessCMOS * devtech->featureSize, NMOS, inputParameter->temperature, *devtech);
 		capCellAccess = CalculateDrainCap(cell->widthAccessCMOS * devtech->featureSize, NMOS, cell->widthInFeatureSize * devtech->featureSize, *devtech);
 		capWordline += CalculateGateCap(cell->widthAccessCMOS * devtech->featureSize, *devtech) * numColumn;
 		capBitline  += capCellAccess * numRow / 2;	/* Due to shared contact */
 		voltagePrecharge = devtech->vdd / 2;	/* DRAM read voltage is always half of vdd */
-	} else if (cell->memCellType == FBRAM){ /* Floating Body RAM */
+	} else if constexpr (cellType == FBRAM){ /* Floating Body RAM */
 		resCellAccess = 0;
 		capCellAccess = CalculateFBRAMDrainCap(cell->widthSOIDevice * tech->featureSize, *tech);
 		capWordline += CalculateFBRAMGateCap(cell->widthSOIDevice * tech->featureSize, cell->gateOxThicknessFactor, *tech) * numColumn;
@@ -288,7 +302,7 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 				}
 			}
 		}
-	} else if (cell->memCellType == MRAM || cell->memCellType == PCRAM || cell->memCellType == memristor) {
+	} else if constexpr (cellType == MRAM || cellType == PCRAM || cellType == memristor) {
 		/* MRAM, PCRAM, and memristor have three types of access devices: CMOS, BJT, and diode */
 		if (cell->accessType == CMOS_access) {
 			resCellAccess = CalculateOnResistance(cell->widthAccessCMOS * tech->featureSize, NMOS, inputParameter->temperature, *tech);
@@ -350,7 +364,7 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 				}
 			}
 		}
-	} else if (cell->memCellType == SLCNAND) {
+	} else if constexpr (cellType == SLCNAND) {
 		/* Calculate the NAND flash string length, which is the page count per block plus 2 (two select transistors) */
 		int pageCount = inputParameter->flashBlockSize / inputParameter->pageSize;
 		int stringLength = pageCount + 2;
@@ -433,6 +447,8 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 }
 
 void SubArray::CalculateArea() {
+	PROFILE(profile_subarray_area);
+	EvalContextScope scope(context);
 	if (!initialized) {
 		cout << "[Subarray] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -494,395 +510,422 @@ void SubArray::CalculateArea() {
 }
 
 void SubArray::CalculateLatency(double _rampInput) {
+	PROFILE(profile_subarray_latency);
+	EvalContextScope scope(context);
 	if (!initialized) {
 		cout << "[Subarray] Error: Require initialization first!" << endl;
 	} else if (invalid) {
 		readLatency = writeLatency = invalid_value;
 	} else {
-		precharger.CalculateLatency(_rampInput);
-		rowDecoder.CalculateLatency(_rampInput);
-		bitlineMuxDecoder.CalculateLatency(_rampInput);
-		senseAmpMuxLev1Decoder.CalculateLatency(_rampInput);
-		senseAmpMuxLev2Decoder.CalculateLatency(_rampInput);
-		columnDecoderLatency = MAX(MAX(bitlineMuxDecoder.readLatency, senseAmpMuxLev1Decoder.readLatency), senseAmpMuxLev2Decoder.readLatency);
-		double decoderLatency = MAX(rowDecoder.readLatency, columnDecoderLatency);
-		/*need a second thought on this equation*/
-		double capPassTransistor = bitlineMux.capNMOSPassTransistor +
-				senseAmpMuxLev1.capNMOSPassTransistor + senseAmpMuxLev2.capNMOSPassTransistor;
-		double resPassTransistor = bitlineMux.resNMOSPassTransistor +
-				senseAmpMuxLev1.resNMOSPassTransistor + senseAmpMuxLev2.resNMOSPassTransistor;
-		double tauChargeLatency = resPassTransistor * (capPassTransistor + capBitline) + resBitline * capBitline / 2;
-		chargeLatency = horowitz(tauChargeLatency, 0, 1e20, NULL);
-
-		if (cell->memCellType == SRAM) {
-			/* Codes below calculate the bitline latency */
-			double resPullDown = CalculateOnResistance(cell->widthSRAMCellNMOS * tech->featureSize, NMOS,
-					inputParameter->temperature, *tech);
-			double tau = (resCellAccess + resPullDown) * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
-					+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2);
-			tau *= log(voltagePrecharge / (voltagePrecharge - senseVoltage / 2));	/* one signal raises and the other drops, so senseVoltage/2 is enough */
-			double gm = CalculateTransconductance(cell->widthAccessCMOS * tech->featureSize, NMOS, *tech);
-			double beta = 1 / (resPullDown * gm);
-			double bitlineRamp = 0;
-			bitlineDelay = horowitz(tau, beta, rowDecoder.rampOutput, &bitlineRamp);
-			bitlineMux.CalculateLatency(bitlineRamp);
-			if (internalSenseAmp) {
-				senseAmp.CalculateLatency(bitlineMuxDecoder.rampOutput);
-				senseAmpMuxLev1.CalculateLatency(1e20);
-				senseAmpMuxLev2.CalculateLatency(senseAmpMuxLev1.rampOutput);
-			} else {
-				senseAmpMuxLev1.CalculateLatency(bitlineMux.rampOutput);
-				senseAmpMuxLev2.CalculateLatency(senseAmpMuxLev1.rampOutput);
-			}
-			readLatency = decoderLatency + bitlineDelay + bitlineMux.readLatency + senseAmp.readLatency
-					+ senseAmpMuxLev1.readLatency + senseAmpMuxLev2.readLatency;
-			/* assume symmetric read/write for SRAM bitline delay */
-			writeLatency = readLatency;
-		} else if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
-			double cap = (capCellAccess + cell->capDRAMCell) * (capBitline + bitlineMux.capForPreviousDelayCalculation)
-					/ (capCellAccess + cell->capDRAMCell + capBitline + bitlineMux.capForPreviousDelayCalculation);
-			double res = resBitline + resCellAccess;
-			double tau = 2.3 * res * cap;
-			double bitlineRamp = 0;
-			bitlineDelay = horowitz(tau, 0, rowDecoder.rampOutput, &bitlineRamp);
-			senseAmp.CalculateLatency(bitlineRamp);
+		(this->*kernel->calculateLatency)(_rampInput);
+	}
+}
+
+template <MemCellType cellType>
+void SubArray::CalculateLatencyKernel(double _rampInput) {
+	precharger.CalculateLatency(_rampInput);
+	rowDecoder.CalculateLatency(_rampInput);
+	bitlineMuxDecoder.CalculateLatency(_rampInput);
+	senseAmpMuxLev1Decoder.CalculateLatency(_rampInput);
+	senseAmpMuxLev2Decoder.CalculateLatency(_rampInput);
+	columnDecoderLatency = MAX(MAX(bitlineMuxDecoder.readLatency, senseAmpMuxLev1Decoder.readLatency), senseAmpMuxLev2Decoder.readLatency);
+	double decoderLatency = MAX(rowDecoder.readLatency, columnDecoderLatency);
+	/*need a second thought on this equation*/
+	double capPassTransistor = bitlineMux.capNMOSPassTransistor +
+			senseAmpMuxLev1.capNMOSPassTransistor + senseAmpMuxLev2.capNMOSPassTransistor;
+	double resPassTransistor = bitlineMux.resNMOSPassTransistor +
+			senseAmpMuxLev1.resNMOSPassTransistor + senseAmpMuxLev2.resNMOSPassTransistor;
+	double tauChargeLatency = resPassTransistor * (capPassTransistor + capBitline) + resBitline * capBitline / 2;
+	chargeLatency = horowitz(tauChargeLatency, 0, 1e20, NULL);
+
+	if constexpr (cellType == SRAM) {
+		/* Codes below calculate the bitline latency */
+		double resPullDown = CalculateOnResistance(cell->widthSRAMCellNMOS * tech->featureSize, NMOS,
+				inputParameter->temperature, *tech);
+		double tau = (resCellAccess + resPullDown) * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
+				+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2);
+		tau *= log(voltagePrecharge / (voltagePrecharge - senseVoltage / 2));	/* one signal raises and the other drops, so senseVoltage/2 is enough */
+		double gm = CalculateTransconductance(cell->widthAccessCMOS * tech->featureSize, NMOS, *tech);
+		double beta = 1 / (resPullDown * gm);
+		double bitlineRamp = 0;
+		bitlineDelay = horowitz(tau, beta, rowDecoder.rampOutput, &bitlineRamp);
+		bitlineMux.CalculateLatency(bitlineRamp);
+		if (internalSenseAmp) {
+			senseAmp.CalculateLatency(bitlineMuxDecoder.rampOutput);
 			senseAmpMuxLev1.CalculateLatency(1e20);
 			senseAmpMuxLev2.CalculateLatency(senseAmpMuxLev1.rampOutput);
+		} else {
+			senseAmpMuxLev1.CalculateLatency(bitlineMux.rampOutput);
+			senseAmpMuxLev2.CalculateLatency(senseAmpMuxLev1.rampOutput);
+		}
+		readLatency = decoderLatency + bitlineDelay + bitlineMux.readLatency + senseAmp.readLatency
+				+ senseAmpMuxLev1.readLatency + senseAmpMuxLev2.readLatency;
+		/* assume symmetric read/write for SRAM bitline delay */
+		writeLatency = readLatency;
+	} else if constexpr (cellType == DRAM || cellType == eDRAM) {
+		double cap = (capCellAccess + cell->capDRAMCell) * (capBitline + bitlineMux.capForPreviousDelayCalculation)
+				/ (capCellAccess + cell->capDRAMCell + capBitline + bitlineMux.capForPreviousDelayCalculation);
+		double res = resBitline + resCellAccess;
+		double tau = 2.3 * res * cap;
+		double bitlineRamp = 0;
+		bitlineDelay = horowitz(tau, 0, rowDecoder.rampOutput, &bitlineRamp);
+		senseAmp.CalculateLatency(bitlineRamp);
+		senseAmpMuxLev1.CalculateLatency(1e20);
+		senseAmpMuxLev2.CalculateLatency(senseAmpMuxLev1.rampOutput);
 
             /* Refresh operation does not pass sense amplifier. */
             refreshLatency = decoderLatency + bitlineDelay + senseAmp.readLatency;
             refreshLatency *= numRow; // TOTAL refresh latency for subarray
-			readLatency = decoderLatency + bitlineDelay + senseAmp.readLatency
-					+ senseAmpMuxLev1.readLatency + senseAmpMuxLev2.readLatency;
-			/* assume symmetric read/write for DRAM/eDRAM bitline delay */
-			writeLatency = readLatency;
-		} else if (cell->memCellType == MRAM || cell->memCellType == PCRAM || cell->memCellType == memristor || cell->memCellType == FBRAM) {
-			double bitlineRamp = 0;
-			if (cell->readMode == false) {	/* current-sensing */
-				/* Use ICCAD 2009 model */
-				double tau = resBitline * capBitline / 2 * (resMemCellOff + resBitline / 3) / (resMemCellOff + resBitline);
+		readLatency = decoderLatency + bitlineDelay + senseAmp.readLatency
+				+ senseAmpMuxLev1.readLatency + senseAmpMuxLev2.readLatency;
+		/* assume symmetric read/write for DRAM/eDRAM bitline delay */
+		writeLatency = readLatency;
+	} else if constexpr (cellType == MRAM || cellType == PCRAM || cellType == memristor || cellType == FBRAM) {
+		double bitlineRamp = 0;
+		if (cell->readMode == false) {	/* current-sensing */
+			/* Use ICCAD 2009 model */
+			double tau = resBitline * capBitline / 2 * (resMemCellOff + resBitline / 3) / (resMemCellOff + resBitline);
                 //tau *= 500.0;
-				bitlineDelay = horowitz(tau, 0, rowDecoder.rampOutput, &bitlineRamp);
-			} else {						/* voltage-sensing */
-				if (cell->readVoltage == 0) {  /* Current-in voltage sensing */
-					double tau = resMemCellOn * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
-							+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2); /* time constant of LRS */
-					bitlineDelayOn = tau * log((voltagePrecharge - voltageMemCellOn)/(voltagePrecharge - voltageMemCellOn - senseVoltage));  /* BitlineDelay of HRS */
-					tau = resMemCellOff * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
-							+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2);  /* time constant of HRS */
-					bitlineDelayOff = tau * log((voltageMemCellOff - voltagePrecharge)/(voltageMemCellOff - voltagePrecharge - senseVoltage));
-					bitlineDelay = MAX(bitlineDelayOn, bitlineDelayOff);
-				} else {   /*Voltage-in voltage sensing */
-					double tau = resEquivalentOn * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
-							+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2); /* time constant of LRS */
-					bitlineDelayOn = tau * log((voltagePrecharge - voltageMemCellOn)/(voltagePrecharge - voltageMemCellOn - senseVoltage));  /* BitlineDelay of HRS */
-
-					tau = resEquivalentOff * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
-							+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2);  /* time constant of HRS */
-					bitlineDelayOff = tau * log((voltageMemCellOff - voltagePrecharge)/(voltageMemCellOff - voltagePrecharge - senseVoltage));
-					bitlineDelay = MAX(bitlineDelayOn, bitlineDelayOff);
-				}
+			bitlineDelay = horowitz(tau, 0, rowDecoder.rampOutput, &bitlineRamp);
+		} else {						/* voltage-sensing */
+			if (cell->readVoltage == 0) {  /* Current-in voltage sensing */
+				double tau = resMemCellOn * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
+						+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2); /* time constant of LRS */
+				bitlineDelayOn = tau * log((voltagePrecharge - voltageMemCellOn)/(voltagePrecharge - voltageMemCellOn - senseVoltage));  /* BitlineDelay of HRS */
+				tau = resMemCellOff * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
+						+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2);  /* time constant of HRS */
+				bitlineDelayOff = tau * log((voltageMemCellOff - voltagePrecharge)/(voltageMemCellOff - voltagePrecharge - senseVoltage));
+				bitlineDelay = MAX(bitlineDelayOn, bitlineDelayOff);
+			} else {   /*Voltage-in voltage sensing */
+				double tau = resEquivalentOn * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
+						+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2); /* time constant of LRS */
+				bitlineDelayOn = tau * log((voltagePrecharge - voltageMemCellOn)/(voltagePrecharge - voltageMemCellOn - senseVoltage));  /* BitlineDelay of HRS */
+
+				tau = resEquivalentOff * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
+						+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2);  /* time constant of HRS */
+				bitlineDelayOff = tau * log((voltageMemCellOff - voltagePrecharge)/(voltageMemCellOff - voltagePrecharge - senseVoltage));
+				bitlineDelay = MAX(bitlineDelayOn, bitlineDelayOff);
 			}
-			bitlineMux.CalculateLatency(bitlineRamp);
-			if (internalSenseAmp) {
-				senseAmp.CalculateLatency(bitlineMuxDecoder.rampOutput);
-				senseAmpMuxLev1.CalculateLatency(1e20);
-				senseAmpMuxLev2.CalculateLatency(senseAmpMuxLev1.rampOutput);
+		}
+		bitlineMux.CalculateLatency(bitlineRamp);
+		if (internalSenseAmp) {
+			senseAmp.CalculateLatency(bitlineMuxDecoder.rampOutput);
+			senseAmpMuxLev1.CalculateLatency(1e20);
+			senseAmpMuxLev2.CalculateLatency(senseAmpMuxLev1.rampOutput);
+		} else {
+			senseAmpMuxLev1.CalculateLatency(bitlineMux.rampOutput);
+			senseAmpMuxLev2.CalculateLatency(senseAmpMuxLev1.rampOutput);
+		}
+		readLatency = decoderLatency + bitlineDelay + bitlineMux.readLatency + senseAmp.readLatency
+				+ senseAmpMuxLev1.readLatency + senseAmpMuxLev2.readLatency;
+
+		if constexpr (cellType == PCRAM) {
+			if (inputParameter->writeScheme == write_and_verify) {
+				/*TO-DO: write and verify programming */
 			} else {
-				senseAmpMuxLev1.CalculateLatency(bitlineMux.rampOutput);
-				senseAmpMuxLev2.CalculateLatency(senseAmpMuxLev1.rampOutput);
+				writeLatency = MAX(rowDecoder.writeLatency, columnDecoderLatency + chargeLatency);	/* TO-DO: why not directly use precharger latency? */
+				resetLatency = writeLatency + cell->resetPulse;
+				setLatency = writeLatency + cell->setPulse;
+				writeLatency += MAX(cell->resetPulse, cell->setPulse);
 			}
-			readLatency = decoderLatency + bitlineDelay + bitlineMux.readLatency + senseAmp.readLatency
-					+ senseAmpMuxLev1.readLatency + senseAmpMuxLev2.readLatency;
-
-			if (cell->memCellType == PCRAM) {
-				if (inputParameter->writeScheme == write_and_verify) {
-					/*TO-DO: write and verify programming */
-				} else {
-					writeLatency = MAX(rowDecoder.writeLatency, columnDecoderLatency + chargeLatency);	/* TO-DO: why not directly use precharger latency? */
-					resetLatency = writeLatency + cell->resetPulse;
-					setLatency = writeLatency + cell->setPulse;
-					writeLatency += MAX(cell->resetPulse, cell->setPulse);
-				}
-			} else if (cell->memCellType == FBRAM) {
+		} else if constexpr (cellType == FBRAM) {
+			writeLatency = MAX(rowDecoder.writeLatency, columnDecoderLatency + chargeLatency);
+			resetLatency = writeLatency + cell->resetPulse;
+			setLatency = writeLatency + cell->setPulse;
+			writeLatency += MAX(cell->resetPulse, cell->setPulse);
+		} else { //memristor and MRAM
+			if (cell->accessType == diode_access || cell->accessType == none_access) {
+				if (inputParameter->writeScheme == erase_before_reset || inputParameter->writeScheme == erase_before_set)
+					writeLatency = MAX(rowDecoder.writeLatency, chargeLatency);
+				else
+					writeLatency = MAX(rowDecoder.writeLatency, columnDecoderLatency + chargeLatency);
+				writeLatency += chargeLatency;
+				writeLatency += cell->resetPulse + cell->setPulse;
+			} else { // CMOS or Bipolar access
 				writeLatency = MAX(rowDecoder.writeLatency, columnDecoderLatency + chargeLatency);
 				resetLatency = writeLatency + cell->resetPulse;
 				setLatency = writeLatency + cell->setPulse;
 				writeLatency += MAX(cell->resetPulse, cell->setPulse);
-			} else { //memristor and MRAM
-				if (cell->accessType == diode_access || cell->accessType == none_access) {
-					if (inputParameter->writeScheme == erase_before_reset || inputParameter->writeScheme == erase_before_set)
-						writeLatency = MAX(rowDecoder.writeLatency, chargeLatency);
-					else
-						writeLatency = MAX(rowDecoder.writeLatency, columnDecoderLatency + chargeLatency);
-					writeLatency += chargeLatency;
-					writeLatency += cell->resetPulse + cell->setPulse;
-				} else { // CMOS or Bipolar access
-					writeLatency = MAX(rowDecoder.writeLatency, columnDecoderLatency + chargeLatency);
-					resetLatency = writeLatency + cell->resetPulse;
-					setLatency = writeLatency + cell->setPulse;
-					writeLatency += MAX(cell->resetPulse, cell->setPulse);
-				}
-			}
-		} else if (cell->memCellType == SLCNAND) {
-			/* Calculate the NAND flash string length, which is the page count per block plus 2 (two select transistors) */
-			int pageCount = inputParameter->flashBlockSize / inputParameter->pageSize;
-			int stringLength = pageCount + 2;
-			/* Codes below calculate the bitline latency */
-			double resPullDown = CalculateOnResistance(tech->featureSize, NMOS, inputParameter->temperature, *tech)
-					* stringLength;
-			double tau = resPullDown * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
-					+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2);
-			/* in one case the bitline is unchanged, and in the other case the bitline drops from 0.6V to 0.4V */
-			tau *= log((voltagePrecharge)/ (voltagePrecharge - senseVoltage));
-			double gm = CalculateTransconductance(tech->featureSize, NMOS, *tech);	/* minimum size transistor */
-			double beta = 1 / (resPullDown * gm);
-			double bitlineRamp = 0;
-			bitlineDelay = horowitz(tau, beta, rowDecoder.rampOutput, &bitlineRamp);
-			/* to correct unnecessary horowitz calculation, TO-DO: need to revisit */
-			bitlineDelay = MAX(bitlineDelay, tau * 20);
-			bitlineMux.CalculateLatency(bitlineRamp);
-			if (internalSenseAmp) {
-				senseAmp.CalculateLatency(bitlineMuxDecoder.rampOutput);
-				senseAmpMuxLev1.CalculateLatency(1e20);
-				senseAmpMuxLev2.CalculateLatency(senseAmpMuxLev1.rampOutput);
-			} else {
-				senseAmpMuxLev1.CalculateLatency(bitlineMux.rampOutput);
-				senseAmpMuxLev2.CalculateLatency(senseAmpMuxLev1.rampOutput);
 			}
-			readLatency = decoderLatency + bitlineDelay + bitlineMux.readLatency + senseAmp.readLatency
-					+ senseAmpMuxLev1.readLatency + senseAmpMuxLev2.readLatency;
-			/* calculate the erase time, a.k.a. reset here */
-			resetLatency = MAX(rowDecoder.readLatency, columnDecoderLatency + chargeLatency) + cell->flashEraseTime;
-			/* calculate the programming time, a.k.a. set here */
-			setLatency = MAX(rowDecoder.readLatency, columnDecoderLatency + chargeLatency) + cell->flashProgramTime;
-			/* use the programming latency as the write latency for SLC NAND*/
-			writeLatency = setLatency;
-		} else {	/* MLC NAND */
-			/* TO-DO */
 		}
+	} else if constexpr (cellType == SLCNAND) {
+		/* Calculate the NAND flash string length, which is the page count per block plus 2 (two select transistors) */
+		int pageCount = inputParameter->flashBlockSize / inputParameter->pageSize;
+		int stringLength = pageCount + 2;
+		/* Codes below calculate the bitline latency */
+		double resPullDown = CalculateOnResistance(tech->featureSize, NMOS, inputParameter->temperature, *tech)
+				* stringLength;
+		double tau = resPullDown * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
+				+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2);
+		/* in one case the bitline is unchanged, and in the other case the bitline drops from 0.6V to 0.4V */
+		tau *= log((voltagePrecharge)/ (voltagePrecharge - senseVoltage));
+		double gm = CalculateTransconductance(tech->featureSize, NMOS, *tech);	/* minimum size transistor */
+		double beta = 1 / (resPullDown * gm);
+		double bitlineRamp = 0;
+		bitlineDelay = horowitz(tau, beta, rowDecoder.rampOutput, &bitlineRamp);
+		/* to correct unnecessary horowitz calculation, TO-DO: need to revisit */
+		bitlineDelay = MAX(bitlineDelay, tau * 20);
+		bitlineMux.CalculateLatency(bitlineRamp);
+		if (internalSenseAmp) {
+			senseAmp.CalculateLatency(bitlineMuxDecoder.rampOutput);
+			senseAmpMuxLev1.CalculateLatency(1e20);
+			senseAmpMuxLev2.CalculateLatency(senseAmpMuxLev1.rampOutput);
+		} else {
+			senseAmpMuxLev1.CalculateLatency(bitlineMux.rampOutput);
+			senseAmpMuxLev2.CalculateLatency(senseAmpMuxLev1.rampOutput);
+		}
+		readLatency = decoderLatency + bitlineDelay + bitlineMux.readLatency + senseAmp.readLatency
+				+ senseAmpMuxLev1.readLatency + senseAmpMuxLev2.readLatency;
+		/* calculate the erase time, a.k.a. reset here */
+		resetLatency = MAX(rowDecoder.readLatency, columnDecoderLatency + chargeLatency) + cell->flashEraseTime;
+		/* calculate the programming time, a.k.a. set here */
+		setLatency = MAX(rowDecoder.readLatency, columnDecoderLatency + chargeLatency) + cell->flashProgramTime;
+		/* use the programming latency as the write latency for SLC NAND*/
+		writeLatency = setLatency;
+	} else {	/* MLC NAND */
+		/* TO-DO */
 	}
 }
 
 void SubArray::CalculatePower() {
+	PROFILE(profile_subarray_power);
+	EvalContextScope scope(context);
 	if (!initialized) {
 		cout << "[Subarray] Error: Require initialization first!" << endl;
 	} else if (invalid) {
 		readDynamicEnergy = writeDynamicEnergy = leakage = invalid_value;
 	} else {
-		precharger.CalculatePower();
-		rowDecoder.CalculatePower();
-		bitlineMuxDecoder.CalculatePower();
-		senseAmpMuxLev1Decoder.CalculatePower();
-		senseAmpMuxLev2Decoder.CalculatePower();
-		bitlineMux.CalculatePower();
-		if (internalSenseAmp) {
-			senseAmp.CalculatePower();
-		}
-		senseAmpMuxLev1.CalculatePower();
-		senseAmpMuxLev2.CalculatePower();
-
-		if (cell->memCellType == SRAM) {
-			/* Codes below calculate the SRAM bitline power */
-			readDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
-					* voltagePrecharge * voltagePrecharge * numColumn;
-			writeDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
-					* voltagePrecharge * voltagePrecharge * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
-			leakage = CalculateGateLeakage(INV, 1, cell->widthSRAMCellNMOS * tech->featureSize,
-					cell->widthSRAMCellPMOS * tech->featureSize, inputParameter->temperature, *tech)
-					* tech->vdd * 2;	/* two inverters per SRAM cell */
-			leakage += CalculateGateLeakage(INV, 1, cell->widthAccessCMOS * tech->featureSize, 0,
-					inputParameter->temperature, *tech) * tech->vdd;	/* two accesses NMOS, but combined as one with vdd crossed */
-			leakage *= numRow * numColumn;
-		} else if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
-			/* Codes below calculate the DRAM bitline power */
-			readDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * senseVoltage * devtech->vdd * numColumn;
+		(this->*kernel->calculatePower)();
+	}
+}
+
+template <MemCellType cellType>
+void SubArray::CalculatePowerKernel() {
+	precharger.CalculatePower();
+	rowDecoder.CalculatePower();
+	bitlineMuxDecoder.CalculatePower();
+	senseAmpMuxLev1Decoder.CalculatePower();
+	senseAmpMuxLev2Decoder.CalculatePower();
+	bitlineMux.CalculatePower();
+	if (internalSenseAmp) {
+		senseAmp.CalculatePower();
+	}
+	senseAmpMuxLev1.CalculatePower();
+	senseAmpMuxLev2.CalculatePower();
+
+	if constexpr (cellType == SRAM) {
+		/* Codes below calculate the SRAM bitline power */
+		readDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
+				* voltagePrecharge * voltagePrecharge * numColumn;
+		writeDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
+				* voltagePrecharge * voltagePrecharge * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
+		leakage = CalculateGateLeakage(INV, 1, cell->widthSRAMCellNMOS * tech->featureSize,
+				cell->widthSRAMCellPMOS * tech->featureSize, inputParameter->temperature, *tech)
+				* tech->vdd * 2;	/* two inverters per SRAM cell */
+		leakage += CalculateGateLeakage(INV, 1, cell->widthAccessCMOS * tech->featureSize, 0,
+				inputParameter->temperature, *tech) * tech->vdd;	/* two accesses NMOS, but combined as one with vdd crossed */
+		leakage *= numRow * numColumn;
+	} else if constexpr (cellType == DRAM || cellType == eDRAM) {
+		/* Codes below calculate the DRAM bitline power */
+		readDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * senseVoltage * devtech->vdd * numColumn;
             refreshDynamicEnergy = readDynamicEnergy;
-			double writeVoltage = cell->resetVoltage;	/* should also equal to setVoltage, for DRAM, it is Vdd */
-			writeDynamicEnergy = (capBitline + bitlineMux.capForPreviousPowerCalculation) * writeVoltage * writeVoltage * numColumn;
-			leakage = readDynamicEnergy / DRAM_REFRESH_PERIOD * numRow;
-		} else if (cell->memCellType == MRAM || cell->memCellType == PCRAM || cell->memCellType == memristor || cell->memCellType == FBRAM) {
-			if (cell->readMode == false) {	/* current-sensing */
-				/* Use ICCAD 2009 model */
-				double resBitlineMux = bitlineMux.resNMOSPassTransistor;
-				double vpreMin = cell->readVoltage * resBitlineMux / (resBitlineMux + resBitline +resMemCellOn);
-				double vpreMax = cell->readVoltage * (resBitlineMux + resBitline) / (resBitlineMux + resBitline + resMemCellOn);
-				readDynamicEnergy = capCellAccess * vpreMax * vpreMax + bitlineMux.capForPreviousPowerCalculation
-						* vpreMin * vpreMin + capBitline * (vpreMax * vpreMax + vpreMin * vpreMin + vpreMax * vpreMin) / 3;
-				readDynamicEnergy *= numColumn;
-			} else {						/* voltage-sensing */
-				readDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) *
-						(voltagePrecharge * voltagePrecharge - voltageMemCellOn * voltageMemCellOn ) * numColumn;
-			}
+		double writeVoltage = cell->resetVoltage;	/* should also equal to setVoltage, for DRAM, it is Vdd */
+		writeDynamicEnergy = (capBitline + bitlineMux.capForPreviousPowerCalculation) * writeVoltage * writeVoltage * numColumn;
+		leakage = readDynamicEnergy / DRAM_REFRESH_PERIOD * numRow;
+	} else if constexpr (cellType == MRAM || cellType == PCRAM || cellType == memristor || cellType == FBRAM) {
+		if (cell->readMode == false) {	/* current-sensing */
+			/* Use ICCAD 2009 model */
+			double resBitlineMux = bitlineMux.resNMOSPassTransistor;
+			double vpreMin = cell->readVoltage * resBitlineMux / (resBitlineMux + resBitline +resMemCellOn);
+			double vpreMax = cell->readVoltage * (resBitlineMux + resBitline) / (resBitlineMux + resBitline + resMemCellOn);
+			readDynamicEnergy = capCellAccess * vpreMax * vpreMax + bitlineMux.capForPreviousPowerCalculation
+					* vpreMin * vpreMin + capBitline * (vpreMax * vpreMax + vpreMin * vpreMin + vpreMax * vpreMin) / 3;
+			readDynamicEnergy *= numColumn;
+		} else {						/* voltage-sensing */
+			readDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) *
+					(voltagePrecharge * voltagePrecharge - voltageMemCellOn * voltageMemCellOn ) * numColumn;
+		}
 
-			if (cell->readPower == 0) 
-				cellReadEnergy = 2 * cell->CalculateReadPower() * senseAmp.readLatency; /* x2 is because of the reference cell */
-			else
-				cellReadEnergy = 2 * cell->readPower * senseAmp.readLatency;
-			cellReadEnergy *= numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
+		if (cell->readPower == 0) 
+			cellReadEnergy = 2 * cell->CalculateReadPower() * senseAmp.readLatency; /* x2 is because of the reference cell */
+		else
+			cellReadEnergy = 2 * cell->readPower * senseAmp.readLatency;
+		cellReadEnergy *= numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
 
-			/* Ignore the dynamic transition during the SET/RESET operation */
-			/* Assume that the cell resistance keeps high for worst-case power estimation */
-			cell->CalculateWriteEnergy();
+		/* Ignore the dynamic transition during the SET/RESET operation */
+		/* Assume that the cell resistance keeps high for worst-case power estimation */
+		cell->CalculateWriteEnergy();
 
-			double resetEnergyPerBit = cell->resetEnergy;
-			double setEnergyPerBit = cell->setEnergy;
-			if (cell->setMode)
-				setEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * cell->setVoltage * cell->setVoltage;
-			else
-				setEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * tech->vdd * tech->vdd;
-			if (cell->resetMode)
-				resetEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * cell->resetVoltage * cell->resetVoltage;
-			else
-				resetEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * tech->vdd * tech->vdd;
+		double resetEnergyPerBit = cell->resetEnergy;
+		double setEnergyPerBit = cell->setEnergy;
+		if (cell->setMode)
+			setEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * cell->setVoltage * cell->setVoltage;
+		else
+			setEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * tech->vdd * tech->vdd;
+		if (cell->resetMode)
+			resetEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * cell->resetVoltage * cell->resetVoltage;
+		else
+			resetEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * tech->vdd * tech->vdd;
 
-			if (cell->memCellType == PCRAM) { //PCRAM write energy
-				if (inputParameter->writeScheme == write_and_verify) {
-					/*TO-DO: write and verify programming */
-				} else {
-					cellResetEnergy = resetEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
-					cellSetEnergy = setEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
-					cellResetEnergy /= SHAPER_EFFICIENCY_CONSERVATIVE;
-					cellSetEnergy /= SHAPER_EFFICIENCY_CONSERVATIVE;  /* Due to the shaper inefficiency */
-					writeDynamicEnergy = MAX(cellResetEnergy, cellSetEnergy);
-				}
-			} else if (cell->memCellType == FBRAM){ //FBRAM write energy
+		if constexpr (cellType == PCRAM) { //PCRAM write energy
+			if (inputParameter->writeScheme == write_and_verify) {
+				/*TO-DO: write and verify programming */
+			} else {
 				cellResetEnergy = resetEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
 				cellSetEnergy = setEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
-				cellResetEnergy /= SHAPER_EFFICIENCY_AGGRESSIVE;
-				cellSetEnergy /= SHAPER_EFFICIENCY_AGGRESSIVE;  /* Due to the shaper inefficiency */
+				cellResetEnergy /= SHAPER_EFFICIENCY_CONSERVATIVE;
+				cellSetEnergy /= SHAPER_EFFICIENCY_CONSERVATIVE;  /* Due to the shaper inefficiency */
 				writeDynamicEnergy = MAX(cellResetEnergy, cellSetEnergy);
-			} else { //MRAM and memristor write energy
-				if (cell->accessType == diode_access || cell->accessType == none_access) {
-					if (inputParameter->writeScheme == erase_before_reset || inputParameter->writeScheme == erase_before_set) {
-						cellResetEnergy = resetEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
-						cellSetEnergy = setEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
-						writeDynamicEnergy = cellResetEnergy + cellSetEnergy;	/* TO-DO: bug here, did you consider the write pattern? */
-					} else { /* write scheme = set_before_reset or reset_before_set */
-						cellResetEnergy = resetEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
-						cellSetEnergy = setEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
-						writeDynamicEnergy = MAX(cellResetEnergy, cellSetEnergy);
-					}
-				} else {
+			}
+		} else if constexpr (cellType == FBRAM){ //FBRAM write energy
+			cellResetEnergy = resetEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
+			cellSetEnergy = setEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
+			cellResetEnergy /= SHAPER_EFFICIENCY_AGGRESSIVE;
+			cellSetEnergy /= SHAPER_EFFICIENCY_AGGRESSIVE;  /* Due to the shaper inefficiency */
+			writeDynamicEnergy = MAX(cellResetEnergy, cellSetEnergy);
+		} else { //MRAM and memristor write energy
+			if (cell->accessType == diode_access || cell->accessType == none_access) {
+				if (inputParameter->writeScheme == erase_before_reset || inputParameter->writeScheme == erase_before_set) {
+					cellResetEnergy = resetEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
+					cellSetEnergy = setEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
+					writeDynamicEnergy = cellResetEnergy + cellSetEnergy;	/* TO-DO: bug here, did you consider the write pattern? */
+				} else { /* write scheme = set_before_reset or reset_before_set */
 					cellResetEnergy = resetEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
 					cellSetEnergy = setEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
 					writeDynamicEnergy = MAX(cellResetEnergy, cellSetEnergy);
 				}
-				cellResetEnergy /= SHAPER_EFFICIENCY_AGGRESSIVE;
-				cellSetEnergy /= SHAPER_EFFICIENCY_AGGRESSIVE;  /* Due to the shaper inefficiency */
-				writeDynamicEnergy /= SHAPER_EFFICIENCY_AGGRESSIVE;
+			} else {
+				cellResetEnergy = resetEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
+				cellSetEnergy = setEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
+				writeDynamicEnergy = MAX(cellResetEnergy, cellSetEnergy);
 			}
-			leakage = 0;                       //TO-DO: cell leaks during read/write operation
-		} else if (cell->memCellType == SLCNAND) {
-			/* Calculate the NAND flash string length, which is the page count per block plus 2 (two select transistors) */
-			int pageCount = inputParameter->flashBlockSize / inputParameter->pageSize;
-			int stringLength = pageCount + 2;
-
-			/* === READ energy === */
-			/* only the selected bitline is charged during the read operation, bitline is charged to Vpre */
-			readDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
-					* voltagePrecharge * voltagePrecharge * numColumn;
-			/* tricky thing here!
-			 * In SLC NAND operation, SSL, GSL, and unselected wordlines in a block are charged to Vpass,
-			 * but the selected wordline is not charged, which is totally different from the other cases.
-			 */
-			rowDecoder.resetDynamicEnergy = rowDecoder.readDynamicEnergy;
-			rowDecoder.setDynamicEnergy = rowDecoder.readDynamicEnergy;
-			double actualWordlineReadEnergy = rowDecoder.readDynamicEnergy / tech->vdd / tech->vdd
-					* cell->flashPassVoltage * cell->flashPassVoltage;	/* approximate calculate, the wordline is charged to Vpass instead of Vdd */
-			actualWordlineReadEnergy = actualWordlineReadEnergy * (numRow / pageCount * stringLength - 1);	/* except the selected wordline itself */
-			rowDecoder.readDynamicEnergy = actualWordlineReadEnergy;	/* update the correct value */
-
-			/* === Programming (SET) energy === */
-			/* first calculate the source line energy (charged to Vdd), which is a part of "bitline" in this scenario */
-			setDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
-					* cell->flashProgramVoltage * cell->flashProgramVoltage * numColumn;
-			/* add tunneling current */
-			/* originally it should be multiplied by numColumn/muxSenseAmp/muxOutputLev1/muxOutputLev2,
-			 * but it is multiplied by numColumn here because all the unselected bitlines also need to precharge to Vdd
-			 */
-			setDynamicEnergy += DELTA_V_TH * TUNNEL_CURRENT_FLOW * cell->area
-					* tech->featureSize * tech->featureSize * cell->flashProgramTime * numColumn;
-			/* in programming, the SSL is precharged to Vdd, which is equal to the original value calculated
-			 * from row decoder
-			 */
-			double actualWordlineSetEnergy = rowDecoder.setDynamicEnergy;
-			/* however, the unselected wordlines in the same block have to precharge to Vpass */
-			actualWordlineSetEnergy += rowDecoder.setDynamicEnergy / tech->vdd / tech->vdd
-					* cell->flashPassVoltage * cell->flashPassVoltage * (numRow / pageCount * stringLength - 1);
-			/* And the selected wordline is precharged to Vpgm */
-			actualWordlineSetEnergy += rowDecoder.setDynamicEnergy / tech->vdd / tech->vdd
-					* cell->flashProgramVoltage * cell->flashProgramVoltage;
-			rowDecoder.setDynamicEnergy = actualWordlineSetEnergy;	/* update the correct value */
-
-			/* === Erase (RESET) energy === */
-			/* in erase, all the bitlines (selected or unselected) and the sourceline are precharged to Vera-Vbi */
-
-			resetDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
-					* (cell->flashEraseVoltage - tech->buildInPotential) * (cell->flashEraseVoltage - tech->buildInPotential);
-			resetDynamicEnergy *= (numColumn + 1);	/* plus 1 is due to the source line */
-			/* the p-well shared by the selected block is precharged to Vera */
-			double wellJunctionCap = tech->capJunction * cell->area * tech->featureSize * tech->featureSize;
-			wellJunctionCap *= inputParameter->flashBlockSize;	/* one block shares the same well */
-			resetDynamicEnergy += wellJunctionCap * cell->flashEraseVoltage * cell->flashEraseVoltage;
-			/* in erase, all the wordlines, SSL, and GSL in unselected block are precharged to Vera * beta
-			 * in selected block, SSL and GSL are precharged to Vera * beta
-			 * here beta is fixed at 0.8
-			 */
-			double beta = 0.8;
-			double actualWordlineResetEnergy = rowDecoder.resetDynamicEnergy / tech->vdd / tech->vdd
-					* (cell->flashEraseVoltage * beta) * (cell->flashEraseVoltage * beta);
-			actualWordlineResetEnergy *= (numRow / pageCount * stringLength - pageCount);
-			rowDecoder.resetDynamicEnergy = actualWordlineResetEnergy;
-
-			/* let write energy to be the average energy per page*/
-			rowDecoder.writeDynamicEnergy = (rowDecoder.setDynamicEnergy + rowDecoder.resetDynamicEnergy / pageCount) / 2;
-			writeDynamicEnergy = (setDynamicEnergy + resetDynamicEnergy / pageCount) / 2;
-
-			/* Assume NAND flash cell does not consume any leakage */
-			leakage = 0;
-		} else {	/* MLC NAND */
-			/* TO-DO */
+			cellResetEnergy /= SHAPER_EFFICIENCY_AGGRESSIVE;
+			cellSetEnergy /= SHAPER_EFFICIENCY_AGGRESSIVE;  /* Due to the shaper inefficiency */
+			writeDynamicEnergy /= SHAPER_EFFICIENCY_AGGRESSIVE;
 		}
+		leakage = 0;                       //TO-DO: cell leaks during read/write operation
+	} else if constexpr (cellType == SLCNAND) {
+		/* Calculate the NAND flash string length, which is the page count per block plus 2 (two select transistors) */
+		int pageCount = inputParameter->flashBlockSize / inputParameter->pageSize;
+		int stringLength = pageCount + 2;
 
-		if (inputParameter->designTarget == cache && inputParameter->cacheAccessMode != sequential_access_mode) {
-			cellResetEnergy /= inputParameter->associativity;
-			cellSetEnergy /= inputParameter->associativity;
-			writeDynamicEnergy /= inputParameter->associativity;
-			resetDynamicEnergy /= inputParameter->associativity;
-			setDynamicEnergy /= inputParameter->associativity;
-		}
+		/* === READ energy === */
+		/* only the selected bitline is charged during the read operation, bitline is charged to Vpre */
+		readDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
+				* voltagePrecharge * voltagePrecharge * numColumn;
+		/* tricky thing here!
+		 * In SLC NAND operation, SSL, GSL, and unselected wordlines in a block are charged to Vpass,
+		 * but the selected wordline is not charged, which is totally different from the other cases.
+		 */
+		rowDecoder.resetDynamicEnergy = rowDecoder.readDynamicEnergy;
+		rowDecoder.setDynamicEnergy = rowDecoder.readDynamicEnergy;
+		double actualWordlineReadEnergy = rowDecoder.readDynamicEnergy / tech->vdd / tech->vdd
+				* cell->flashPassVoltage * cell->flashPassVoltage;	/* approximate calculate, the wordline is charged to Vpass instead of Vdd */
+		actualWordlineReadEnergy = actualWordlineReadEnergy * (numRow / pageCount * stringLength - 1);	/* except the selected wordline itself */
+		rowDecoder.readDynamicEnergy = actualWordlineReadEnergy;	/* update the correct value */
+
+		/* === Programming (SET) energy === */
+		/* first calculate the source line energy (charged to Vdd), which is a part of "bitline" in this scenario */
+		setDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
+				* cell->flashProgramVoltage * cell->flashProgramVoltage * numColumn;
+		/* add tunneling current */
+		/* originally it should be multiplied by numColumn/muxSenseAmp/muxOutputLev1/muxOutputLev2,
+		 * but it is multiplied by numColumn here because all the unselected bitlines also need to precharge to Vdd
+		 */
+		setDynamicEnergy += DELTA_V_TH * TUNNEL_CURRENT_FLOW * cell->area
+				* tech->featureSize * tech->featureSize * cell->flashProgramTime * numColumn;
+		/* in programming, the SSL is precharged to Vdd, which is equal to the original value calculated
+		 * from row decoder
+		 */
+		double actualWordlineSetEnergy = rowDecoder.setDynamicEnergy;
+		/* however, the unselected wordlines in the same block have to precharge to Vpass */
+		actualWordlineSetEnergy += rowDecoder.setDynamicEnergy / tech->vdd / tech->vdd
+				* cell->flashPassVoltage * cell->flashPassVoltage * (numRow / pageCount * stringLength - 1);
+		/* And the selected wordline is precharged to Vpgm */
+		actualWordlineSetEnergy += rowDecoder.setDynamicEnergy / tech->vdd / tech->vdd
+				* cell->flashProgramVoltage * cell->flashProgramVoltage;
+		rowDecoder.setDynamicEnergy = actualWordlineSetEnergy;	/* update the correct value */
+
+		/* === Erase (RESET) energy === */
+		/* in erase, all the bitlines (selected or unselected) and the sourceline are precharged to Vera-Vbi */
+
+		resetDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
+				* (cell->flashEraseVoltage - tech->buildInPotential) * (cell->flashEraseVoltage - tech->buildInPotential);
+		resetDynamicEnergy *= (numColumn + 1);	/* plus 1 is due to the source line */
+		/* the p-well shared by the selected block is precharged to Vera */
+		double wellJunctionCap = tech->capJunction * cell->area * tech->featureSize * tech->featureSize;
+		wellJunctionCap *= inputParameter->flashBlockSize;	/* one block shares the same well */
+		resetDynamicEnergy += wellJunctionCap * cell->flashEraseVoltage * cell->flashEraseVoltage;
+		/* in erase, all the wordlines, SSL, and GSL in unselected block are precharged to Vera * beta
+		 * in selected block, SSL and GSL are precharged to Vera * beta
+		 * here beta is fixed at 0.8
+		 */
+		double beta = 0.8;
+		double actualWordlineResetEnergy = rowDecoder.resetDynamicEnergy / tech->vdd / tech->vdd
+				* (cell->flashEraseVoltage * beta) * (cell->flashEraseVoltage * beta);
+		actualWordlineResetEnergy *= (numRow / pageCount * stringLength - pageCount);
+		rowDecoder.resetDynamicEnergy = actualWordlineResetEnergy;
+
+		/* let write energy to be the average energy per page*/
+		rowDecoder.writeDynamicEnergy = (rowDecoder.setDynamicEnergy + rowDecoder.resetDynamicEnergy / pageCount) / 2;
+		writeDynamicEnergy = (setDynamicEnergy + resetDynamicEnergy / pageCount) / 2;
+
+		/* Assume NAND flash cell does not consume any leakage */
+		leakage = 0;
+	} else {	/* MLC NAND */
+		/* TO-DO */
+	}
 
-		readDynamicEnergy += cellReadEnergy + rowDecoder.readDynamicEnergy + bitlineMuxDecoder.readDynamicEnergy + senseAmpMuxLev1Decoder.readDynamicEnergy
-				+ senseAmpMuxLev2Decoder.readDynamicEnergy + precharger.readDynamicEnergy + bitlineMux.readDynamicEnergy
-				+ senseAmp.readDynamicEnergy + senseAmpMuxLev1.readDynamicEnergy + senseAmpMuxLev2.readDynamicEnergy;
-		writeDynamicEnergy += rowDecoder.writeDynamicEnergy + bitlineMuxDecoder.writeDynamicEnergy + senseAmpMuxLev1Decoder.writeDynamicEnergy
-				+ senseAmpMuxLev2Decoder.writeDynamicEnergy + bitlineMux.writeDynamicEnergy
-				+ senseAmp.writeDynamicEnergy + senseAmpMuxLev1.writeDynamicEnergy + senseAmpMuxLev2.writeDynamicEnergy;
+	if (inputParameter->designTarget == cache && inputParameter->cacheAccessMode != sequential_access_mode) {
+		cellResetEnergy /= inputParameter->associativity;
+		cellSetEnergy /= inputParameter->associativity;
+		writeDynamicEnergy /= inputParameter->associativity;
+		resetDynamicEnergy /= inputParameter->associativity;
+		setDynamicEnergy /= inputParameter->associativity;
+	}
+
+	readDynamicEnergy += cellReadEnergy + rowDecoder.readDynamicEnergy + bitlineMuxDecoder.readDynamicEnergy + senseAmpMuxLev1Decoder.readDynamicEnergy
+			+ senseAmpMuxLev2Decoder.readDynamicEnergy + precharger.readDynamicEnergy + bitlineMux.readDynamicEnergy
+			+ senseAmp.readDynamicEnergy + senseAmpMuxLev1.readDynamicEnergy + senseAmpMuxLev2.readDynamicEnergy;
+	writeDynamicEnergy += rowDecoder.writeDynamicEnergy + bitlineMuxDecoder.writeDynamicEnergy + senseAmpMuxLev1Decoder.writeDynamicEnergy
+			+ senseAmpMuxLev2Decoder.writeDynamicEnergy + bitlineMux.writeDynamicEnergy
+			+ senseAmp.writeDynamicEnergy + senseAmpMuxLev1.writeDynamicEnergy + senseAmpMuxLev2.writeDynamicEnergy;
 
         /* Read all column energy + row decoder + sense amp + precharger is enough for one subarray row REF. */
         refreshDynamicEnergy += rowDecoder.readDynamicEnergy + precharger.readDynamicEnergy
                              + senseAmp.readDynamicEnergy;
         refreshDynamicEnergy *= numRow; // Energy for this entire subarray 
 
-		/* for assymetric RESET and SET latency calculation only */
-		setDynamicEnergy += cellSetEnergy + rowDecoder.setDynamicEnergy + bitlineMuxDecoder.writeDynamicEnergy + senseAmpMuxLev1Decoder.writeDynamicEnergy
-				+ senseAmpMuxLev2Decoder.writeDynamicEnergy + bitlineMux.writeDynamicEnergy
-				+ senseAmp.writeDynamicEnergy + senseAmpMuxLev1.writeDynamicEnergy + senseAmpMuxLev2.writeDynamicEnergy;
-		resetDynamicEnergy += setDynamicEnergy + rowDecoder.resetDynamicEnergy + bitlineMuxDecoder.writeDynamicEnergy + senseAmpMuxLev1Decoder.writeDynamicEnergy
-				+ senseAmpMuxLev2Decoder.writeDynamicEnergy + bitlineMux.writeDynamicEnergy
-				+ senseAmp.writeDynamicEnergy + senseAmpMuxLev1.writeDynamicEnergy + senseAmpMuxLev2.writeDynamicEnergy;
-
-		if (cell->accessType == diode_access || cell->accessType == none_access) {
-			writeDynamicEnergy += bitlineMux.writeDynamicEnergy + senseAmp.writeDynamicEnergy
-					+ senseAmpMuxLev1.writeDynamicEnergy + senseAmpMuxLev2.writeDynamicEnergy;
-		}
-		leakage += rowDecoder.leakage + bitlineMuxDecoder.leakage + senseAmpMuxLev1Decoder.leakage
-				+ senseAmpMuxLev2Decoder.leakage + precharger.leakage + bitlineMux.leakage
-				+ senseAmp.leakage + senseAmpMuxLev1.leakage + senseAmpMuxLev2.leakage;
+	/* for assymetric RESET and SET latency calculation only */
+	setDynamicEnergy += cellSetEnergy + rowDecoder.setDynamicEnergy + bitlineMuxDecoder.writeDynamicEnergy + senseAmpMuxLev1Decoder.writeDynamicEnergy
+			+ senseAmpMuxLev2Decoder.writeDynamicEnergy + bitlineMux.writeDynamicEnergy
+			+ senseAmp.writeDynamicEnergy + senseAmpMuxLev1.writeDynamicEnergy + senseAmpMuxLev2.writeDynamicEnergy;
+	resetDynamicEnergy += setDynamicEnergy + rowDecoder.resetDynamicEnergy + bitlineMuxDecoder.writeDynamicEnergy + senseAmpMuxLev1Decoder.writeDynamicEnergy
+			+ senseAmpMuxLev2Decoder.writeDynamicEnergy + bitlineMux.writeDynamicEnergy
+			+ senseAmp.writeDynamicEnergy + senseAmpMuxLev1.writeDynamicEnergy + senseAmpMuxLev2.writeDynamicEnergy;
+
+	if (cell->accessType == diode_access || cell->accessType == none_access) {
+		writeDynamicEnergy += bitlineMux.writeDynamicEnergy + senseAmp.writeDynamicEnergy
+				+ senseAmpMuxLev1.writeDynamicEnergy + senseAmpMuxLev2.writeDynamicEnergy;
 	}
+	leakage += rowDecoder.leakage + bitlineMuxDecoder.leakage + senseAmpMuxLev1Decoder.leakage
+			+ senseAmpMuxLev2Decoder.leakage + precharger.leakage + bitlineMux.leakage
+			+ senseAmp.leakage + senseAmpMuxLev1.leakage + senseAmpMuxLev2.leakage;
 }
 
+/* In the order of MemCellType */
+const SubArray::Kernel SubArray::kernels[MLCNAND + 1] = {
+	{&SubArray::InitializeKernel<SRAM>, &SubArray::CalculateLatencyKernel<SRAM>, &SubArray::CalculatePowerKernel<SRAM>},
+	{&SubArray::InitializeKernel<DRAM>, &SubArray::CalculateLatencyKernel<DRAM>, &SubArray::CalculatePowerKernel<DRAM>},
+	{&SubArray::InitializeKernel<eDRAM>, &SubArray::CalculateLatencyKernel<eDRAM>, &SubArray::CalculatePowerKernel<eDRAM>},
+	{&SubArray::InitializeKernel<MRAM>, &SubArray::CalculateLatencyKernel<MRAM>, &SubArray::CalculatePowerKernel<MRAM>},
+	{&SubArray::InitializeKernel<PCRAM>, &SubArray::CalculateLatencyKernel<PCRAM>, &SubArray::CalculatePowerKernel<PCRAM>},
+	{&SubArray::InitializeKernel<memristor>, &SubArray::CalculateLatencyKernel<memristor>, &SubArray::CalculatePowerKernel<memristor>},
+	{&SubArray::InitializeKernel<FBRAM>, &SubArray::CalculateLatencyKernel<FBRAM>, &SubArray::CalculatePowerKernel<FBRAM>},
+	{&SubArray::InitializeKernel<SLCNAND>, &SubArray::CalculateLatencyKernel<SLCNAND>, &SubArray::CalculatePowerKernel<SLCNAND>},
+	{&SubArray::InitializeKernel<MLCNAND>, &SubArray::CalculateLatencyKernel<MLCNAND>, &SubArray::CalculatePowerKernel<MLCNAND>}
+};
+
 void SubArray::PrintProperty() {
 	cout << "Subarray Properties:" << endl;
 	FunctionUnit::PrintProperty();
@@ -915,6 +958,7 @@ SubArray & SubArray::operator=(const SubArray &rhs) {
 	cellSetEnergy = rhs.cellSetEnergy;
 	leakage = rhs.leakage;
 	initialized = rhs.initialized;
+	invalid = rhs.invalid;
 	numRow = rhs.numRow;
 	numColumn = rhs.numColumn;
 	multipleRowPerSet = rhs.multipleRowPerSet;
@@ -928,6 +972,7 @@ SubArray & SubArray::operator=(const SubArray &rhs) {
 
 	voltageSense = rhs.voltageSense;
 	senseVoltage = rhs.senseVoltage;
+	voltagePrecharge = rhs.voltagePrecharge;
 	numSenseAmp = rhs.numSenseAmp;
 	lenWordline = rhs.lenWordline;
 	lenBitline = rhs.lenBitline;
@@ -947,6 +992,8 @@ SubArray & SubArray::operator=(const SubArray &rhs) {
 	resEquivalentOff = rhs.resEquivalentOff;
 	resMemCellOff = rhs.resMemCellOff;
 	resMemCellOn = rhs.resMemCellOn;
+	voltageMemCellOff = rhs.voltageMemCellOff;
+	voltageMemCellOn = rhs.voltageMemCellOn;
 
 	rowDecoder = rhs.rowDecoder;
 	bitlineMuxDecoder = rhs.bitlineMuxDecoder;
@@ -957,6 +1004,7 @@ SubArray & SubArray::operator=(const SubArray &rhs) {
 	senseAmpMuxLev2 = rhs.senseAmpMuxLev2;
 	precharger = rhs.precharger;
 	senseAmp = rhs.senseAmp;
+	kernel = rhs.kernel;
 
 	return *this;
 }
@@ -16,6 +16,8 @@
 #include "Mux.h"
 #include "typedef.h"
 
+class EvalContext;
+
 class SubArray: public FunctionUnit {
 public:
 	SubArray();
@@ -25,7 +27,7 @@ public:
 	void PrintProperty();
 	void Initialize(long long _numRow, long long _numColumn, bool _multipleRowPerSet, bool _split,
 			int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
-			BufferDesignTarget _areaOptimizationLevel, int _num3DLevels);
+			BufferDesignTarget _areaOptimizationLevel, int _num3DLevels, EvalContext *_context = NULL);
 	void CalculateArea();
 	//void CalculateRC();
 	void CalculateLatency(double _rampInput);
@@ -80,6 +82,23 @@ public:
 	Mux			senseAmpMuxLev2;
 	Precharger	precharger;
 	SenseAmp	senseAmp;
+
+	EvalContext *context;	/* The evaluation state, NULL if the state bound to the calling thread is used */
+
+private:
+	/* The cell-dependent part of Initialize, CalculateLatency and CalculatePower for one cell type.
+	 * The cell type is a template parameter, so every kernel only contains the code of its own cell */
+	struct Kernel {
+		void (SubArray::*initialize)();
+		void (SubArray::*calculateLatency)(double _rampInput);
+		void (SubArray::*calculatePower)();
+	};
+	template <MemCellType cellType> void InitializeKernel();
+	template <MemCellType cellType> void CalculateLatencyKernel(double _rampInput);
+	template <MemCellType cellType> void CalculatePowerKernel();
+
+	static const Kernel kernels[MLCNAND + 1];	/* Indexed by MemCellType */
+	const Kernel *kernel;	/* Of the cell that the subarray is initialized with */
 };
 
 #endif /* SUBARRAY_H_ */
@@ -0,0 +1,238 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "SubArrayCache.h"
+#include "formula.h"
+#include "global.h"
+#include <iostream>
+#include <functional>
+#include <atomic>
+
+/* Bound on the memory of each map of the cache, a full map is emptied, Unit: byte */
+#define MAX_SUBARRAY_CACHE_BYTE	(16 << 20)
+
+/* Memory of a map entry: the key, the value, the node link, the cached hash, the bucket and the heap header */
+#define INITIALIZED_ENTRY_BYTE	(sizeof(SubArrayKey) + sizeof(SubArrayArea) + 4 * sizeof(void *))
+#define CALCULATED_ENTRY_BYTE	(sizeof(SubArrayKey) + sizeof(SubArrayResult) + 4 * sizeof(void *))
+
+/* Hits and misses of the threads that have finished, and the largest memory of their caches */
+static atomic<long long> totalInitializedHit(0);
+static atomic<long long> totalInitializedMiss(0);
+static atomic<long long> totalCalculatedHit(0);
+static atomic<long long> totalCalculatedMiss(0);
+static atomic<long long> maxPeakInitializedByte(0);
+static atomic<long long> maxPeakCalculatedByte(0);
+
+/* Raises peak to value */
+static void UpdatePeak(atomic<long long> &peak, long long value) {
+	long long current = peak;
+	while (value > current && !peak.compare_exchange_weak(current, value));
+}
+
+bool SubArrayKey::operator==(const SubArrayKey &rhs) const {
+	return numRow == rhs.numRow && numColumn == rhs.numColumn
+			&& multipleRowPerSet == rhs.multipleRowPerSet && split == rhs.split
+			&& muxSenseAmp == rhs.muxSenseAmp && internalSenseAmp == rhs.internalSenseAmp
+			&& muxOutputLev1 == rhs.muxOutputLev1 && muxOutputLev2 == rhs.muxOutputLev2
+			&& areaOptimizationLevel == rhs.areaOptimizationLevel && num3DLevels == rhs.num3DLevels
+			&& tech == rhs.tech && devtech == rhs.devtech && cell == rhs.cell && localWire == rhs.localWire
+			&& localWireType == rhs.localWireType && localWireRepeaterType == rhs.localWireRepeaterType
+			&& isLocalWireLowSwing == rhs.isLocalWireLowSwing && rampInput == rhs.rampInput;
+}
+
+size_t SubArrayKeyHash::operator()(const SubArrayKey &key) const {
+	size_t seed = 0;
+	size_t values[] = {
+			hash<long long>()(key.numRow), hash<long long>()(key.numColumn),
+			hash<int>()(key.multipleRowPerSet + 2 * key.split + 4 * key.internalSenseAmp + 8 * key.isLocalWireLowSwing),
+			hash<int>()(key.muxSenseAmp), hash<int>()(key.muxOutputLev1), hash<int>()(key.muxOutputLev2),
+			hash<int>()(key.areaOptimizationLevel), hash<int>()(key.num3DLevels),
+			hash<const void *>()(key.tech), hash<const void *>()(key.devtech),
+			hash<const void *>()(key.cell), hash<const void *>()(key.localWire),
+			hash<int>()(key.localWireType), hash<int>()(key.localWireRepeaterType),
+			hash<double>()(key.rampInput)
+	};
+	for (int i = 0; i < (int)(sizeof(values) / sizeof(values[0])); i++)
+		seed ^= values[i] + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	return seed;
+}
+
+void SubArrayArea::Save(const SubArray &subarray) {
+	invalid = subarray.invalid;
+	numRow = subarray.numRow;
+	numColumn = subarray.numColumn;
+	height = subarray.height;
+	width = subarray.width;
+	area = subarray.area;
+}
+
+void SubArrayArea::Restore(SubArray &subarray) const {
+	subarray.initialized = false;
+	subarray.invalid = invalid;
+	subarray.numRow = numRow;
+	subarray.numColumn = numColumn;
+	subarray.height = height;
+	subarray.width = width;
+	subarray.area = area;
+}
+
+void SubArrayResult::Save(const SubArray &_subarray) {
+	subarray = _subarray;
+	rowDecoder = _subarray.rowDecoder;
+	bitlineMuxDecoder = _subarray.bitlineMuxDecoder;
+	bitlineMux = _subarray.bitlineMux;
+	senseAmpMuxLev1Decoder = _subarray.senseAmpMuxLev1Decoder;
+	senseAmpMuxLev1 = _subarray.senseAmpMuxLev1;
+	senseAmpMuxLev2Decoder = _subarray.senseAmpMuxLev2Decoder;
+	senseAmpMuxLev2 = _subarray.senseAmpMuxLev2;
+	precharger = _subarray.precharger;
+	senseAmp = _subarray.senseAmp;
+	voltagePrecharge = _subarray.voltagePrecharge;
+	capBitline = _subarray.capBitline;
+	resBitline = _subarray.resBitline;
+	resMemCellOff = _subarray.resMemCellOff;
+	resMemCellOn = _subarray.resMemCellOn;
+	voltageMemCellOff = _subarray.voltageMemCellOff;
+	voltageMemCellOn = _subarray.voltageMemCellOn;
+	resEquivalentOn = _subarray.resEquivalentOn;
+	resEquivalentOff = _subarray.resEquivalentOff;
+	bitlineDelay = _subarray.bitlineDelay;
+	chargeLatency = _subarray.chargeLatency;
+	columnDecoderLatency = _subarray.columnDecoderLatency;
+	bitlineDelayOn = _subarray.bitlineDelayOn;
+	bitlineDelayOff = _subarray.bitlineDelayOff;
+}
+
+void SubArrayResult::Restore(SubArray &_subarray) const {
+	/* Only the FunctionUnit part of the subarray and of its sub-components is assigned */
+	(FunctionUnit &)_subarray = subarray;
+	(FunctionUnit &)_subarray.rowDecoder = rowDecoder;
+	(FunctionUnit &)_subarray.bitlineMuxDecoder = bitlineMuxDecoder;
+	(FunctionUnit &)_subarray.bitlineMux = bitlineMux;
+	(FunctionUnit &)_subarray.senseAmpMuxLev1Decoder = senseAmpMuxLev1Decoder;
+	(FunctionUnit &)_subarray.senseAmpMuxLev1 = senseAmpMuxLev1;
+	(FunctionUnit &)_subarray.senseAmpMuxLev2Decoder = senseAmpMuxLev2Decoder;
+	(FunctionUnit &)_subarray.senseAmpMuxLev2 = senseAmpMuxLev2;
+	(FunctionUnit &)_subarray.precharger = precharger;
+	(FunctionUnit &)_subarray.senseAmp = senseAmp;
+	_subarray.voltagePrecharge = voltagePrecharge;
+	_subarray.capBitline = capBitline;
+	_subarray.resBitline = resBitline;
+	_subarray.resMemCellOff = resMemCellOff;
+	_subarray.resMemCellOn = resMemCellOn;
+	_subarray.voltageMemCellOff = voltageMemCellOff;
+	_subarray.voltageMemCellOn = voltageMemCellOn;
+	_subarray.resEquivalentOn = resEquivalentOn;
+	_subarray.resEquivalentOff = resEquivalentOff;
+	_subarray.bitlineDelay = bitlineDelay;
+	_subarray.chargeLatency = chargeLatency;
+	_subarray.columnDecoderLatency = columnDecoderLatency;
+	_subarray.bitlineDelayOn = bitlineDelayOn;
+	_subarray.bitlineDelayOff = bitlineDelayOff;
+}
+
+SubArrayCache::SubArrayCache() {
+	numInitializedHit = numInitializedMiss = 0;
+	numCalculatedHit = numCalculatedMiss = 0;
+	peakInitializedByte = peakCalculatedByte = 0;
+}
+
+SubArrayCache::~SubArrayCache() {
+	totalInitializedHit += numInitializedHit;
+	totalInitializedMiss += numInitializedMiss;
+	totalCalculatedHit += numCalculatedHit;
+	totalCalculatedMiss += numCalculatedMiss;
+	UpdatePeak(maxPeakInitializedByte, peakInitializedByte);
+	UpdatePeak(maxPeakCalculatedByte, peakCalculatedByte);
+}
+
+SubArrayCache & SubArrayCache::ThreadCache() {
+	static thread_local SubArrayCache cache;
+	return cache;
+}
+
+SubArrayKey SubArrayCache::MakeKey(long long _numRow, long long _numColumn, bool _multipleRowPerSet, bool _split,
+		int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
+		BufferDesignTarget _areaOptimizationLevel, int _num3DLevels) {
+	SubArrayKey key;
+	key.numRow = _numRow;
+	key.numColumn = _numColumn;
+	key.multipleRowPerSet = _multipleRowPerSet;
+	key.split = _split;
+	key.muxSenseAmp = _muxSenseAmp;
+	key.internalSenseAmp = _internalSenseAmp;
+	key.muxOutputLev1 = _muxOutputLev1;
+	key.muxOutputLev2 = _muxOutputLev2;
+	key.areaOptimizationLevel = _areaOptimizationLevel;
+	key.num3DLevels = _num3DLevels;
+	key.tech = tech;
+	key.devtech = devtech;
+	key.cell = cell;
+	key.localWire = localWire;
+	key.localWireType = localWire->wireType;
+	key.localWireRepeaterType = localWire->wireRepeaterType;
+	key.isLocalWireLowSwing = localWire->isLowSwing;
+	key.rampInput = 0;
+	return key;
+}
+
+bool SubArrayCache::LoadInitialized(const SubArrayKey &key, SubArray &subarray) {
+	unordered_map<SubArrayKey, SubArrayArea, SubArrayKeyHash>::const_iterator it = initialized.find(key);
+	if (it == initialized.end()) {
+		numInitializedMiss++;
+		return false;
+	}
+	numInitializedHit++;
+	it->second.Restore(subarray);
+	return true;
+}
+
+void SubArrayCache::StoreInitialized(const SubArrayKey &key, const SubArray &subarray) {
+	if ((initialized.size() + 1) * INITIALIZED_ENTRY_BYTE > MAX_SUBARRAY_CACHE_BYTE)
+		initialized.clear();
+	initialized[key].Save(subarray);
+	peakInitializedByte = MAX(peakInitializedByte, (long long)(initialized.size() * INITIALIZED_ENTRY_BYTE));
+}
+
+bool SubArrayCache::LoadCalculated(const SubArrayKey &key, double rampInput, SubArray &subarray) {
+	SubArrayKey calculatedKey = key;
+	calculatedKey.rampInput = rampInput;
+	unordered_map<SubArrayKey, SubArrayResult, SubArrayKeyHash>::const_iterator it = calculated.find(calculatedKey);
+	if (it == calculated.end()) {
+		numCalculatedMiss++;
+		return false;
+	}
+	numCalculatedHit++;
+	it->second.Restore(subarray);
+	return true;
+}
+
+void SubArrayCache::StoreCalculated(const SubArrayKey &key, double rampInput, const SubArray &subarray) {
+	SubArrayKey calculatedKey = key;
+	calculatedKey.rampInput = rampInput;
+	if ((calculated.size() + 1) * CALCULATED_ENTRY_BYTE > MAX_SUBARRAY_CACHE_BYTE)
+		calculated.clear();
+	calculated[calculatedKey].Save(subarray);
+	peakCalculatedByte = MAX(peakCalculatedByte, (long long)(calculated.size() * CALCULATED_ENTRY_BYTE));
+}
+
+void SubArrayCache::PrintStatistics() {
+	SubArrayCache &cache = ThreadCache();
+	long long initializedHit = totalInitializedHit + cache.numInitializedHit;
+	long long initializedMiss = totalInitializedMiss + cache.numInitializedMiss;
+	long long calculatedHit = totalCalculatedHit + cache.numCalculatedHit;
+	long long calculatedMiss = totalCalculatedMiss + cache.numCalculatedMiss;
+	long long peakInitializedByte = MAX(maxPeakInitializedByte.load(), cache.peakInitializedByte);
+	long long peakCalculatedByte = MAX(maxPeakCalculatedByte.load(), cache.peakCalculatedByte);
+	cout << "Subarray cache (initialize/area): " << initializedHit << " hits, " << initializedMiss << " misses";
+	if (initializedHit + initializedMiss > 0)
+		cout << " (" << 100.0 * initializedHit / (initializedHit + initializedMiss) << "% hit rate)";
+	cout << ", " << peakInitializedByte / 1024 << " KB per thread" << endl;
+	cout << "Subarray cache (latency/power)  : " << calculatedHit << " hits, " << calculatedMiss << " misses";
+	if (calculatedHit + calculatedMiss > 0)
+		cout << " (" << 100.0 * calculatedHit / (calculatedHit + calculatedMiss) << "% hit rate)";
+	cout << ", " << peakCalculatedByte / 1024 << " KB per thread" << endl;
+}
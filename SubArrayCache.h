@@ -0,0 +1,127 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef SUBARRAYCACHE_H_
+#define SUBARRAYCACHE_H_
+
+#include <unordered_map>
+#include "SubArray.h"
+#include "typedef.h"
+
+using namespace std;
+
+/* Everything that a subarray evaluation depends on. The technology, the memory cell and the
+ * local wire are identified by the objects bound to the calling thread, which are not modified
+ * in any way that the subarray sees while the designs are explored */
+struct SubArrayKey {
+	long long numRow;
+	long long numColumn;
+	bool multipleRowPerSet;
+	bool split;
+	int muxSenseAmp;
+	bool internalSenseAmp;
+	int muxOutputLev1;
+	int muxOutputLev2;
+	BufferDesignTarget areaOptimizationLevel;
+	int num3DLevels;
+	const void *tech;
+	const void *devtech;
+	const void *cell;
+	const void *localWire;
+	int localWireType;
+	int localWireRepeaterType;
+	bool isLocalWireLowSwing;
+	double rampInput;	/* Only used by the calculated subarrays */
+
+	bool operator==(const SubArrayKey &rhs) const;
+};
+
+struct SubArrayKeyHash {
+	size_t operator()(const SubArrayKey &key) const;
+};
+
+/* The results of SubArray::Initialize and SubArray::CalculateArea that the mat reads. The state of the
+ * subarray is not kept, so a subarray that is restored from it is not initialized */
+struct SubArrayArea {
+	bool invalid;
+	long long numRow;
+	long long numColumn;
+	double height;
+	double width;
+	double area;
+
+	void Save(const SubArray &subarray);
+	void Restore(SubArray &subarray) const;
+};
+
+/* The results of SubArray::CalculateLatency and SubArray::CalculatePower that the mat, the bank and the
+ * result read: the outputs of the subarray and of its sub-components, and the bitline properties */
+struct SubArrayResult {
+	FunctionUnit subarray;
+	FunctionUnit rowDecoder;
+	FunctionUnit bitlineMuxDecoder;
+	FunctionUnit bitlineMux;
+	FunctionUnit senseAmpMuxLev1Decoder;
+	FunctionUnit senseAmpMuxLev1;
+	FunctionUnit senseAmpMuxLev2Decoder;
+	FunctionUnit senseAmpMuxLev2;
+	FunctionUnit precharger;
+	FunctionUnit senseAmp;
+	double voltagePrecharge;
+	double capBitline;
+	double resBitline;
+	double resMemCellOff;
+	double resMemCellOn;
+	double voltageMemCellOff;
+	double voltageMemCellOn;
+	double resEquivalentOn;
+	double resEquivalentOff;
+	double bitlineDelay;
+	double chargeLatency;
+	double columnDecoderLatency;
+	double bitlineDelayOn;
+	double bitlineDelayOff;
+
+	void Save(const SubArray &subarray);
+	void Restore(SubArray &subarray) const;
+};
+
+/* Memoizes the subarrays that the mats of the explored designs evaluate. Many bank organizations
+ * share the same subarray, so a subarray is only evaluated the first time it is seen:
+ *   - initialized subarrays keep the SubArrayArea after SubArray::Initialize and SubArray::CalculateArea
+ *   - calculated subarrays keep the SubArrayResult after SubArray::CalculateLatency and SubArray::CalculatePower
+ * Only the results are kept, the mat initializes the subarray again if it has to calculate its latency.
+ * Each of the two maps is bounded in memory. Every thread has its own cache, so that no locking is needed */
+class SubArrayCache {
+public:
+	SubArrayCache();
+	virtual ~SubArrayCache();
+
+	/* Functions */
+	static SubArrayCache & ThreadCache();	/* The cache of the calling thread */
+	static SubArrayKey MakeKey(long long _numRow, long long _numColumn, bool _multipleRowPerSet, bool _split,
+			int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
+			BufferDesignTarget _areaOptimizationLevel, int _num3DLevels);
+	bool LoadInitialized(const SubArrayKey &key, SubArray &subarray);
+	void StoreInitialized(const SubArrayKey &key, const SubArray &subarray);
+	bool LoadCalculated(const SubArrayKey &key, double rampInput, SubArray &subarray);
+	void StoreCalculated(const SubArrayKey &key, double rampInput, const SubArray &subarray);
+	static void PrintStatistics();	/* Hits and misses of all the threads, and the largest memory of a thread */
+
+	/* Properties */
+	long long numInitializedHit;
+	long long numInitializedMiss;
+	long long numCalculatedHit;
+	long long numCalculatedMiss;
+	long long peakInitializedByte;	/* Largest memory used by the initialized subarrays, Unit: byte */
+	long long peakCalculatedByte;	/* Largest memory used by the calculated subarrays, Unit: byte */
+
+private:
+	unordered_map<SubArrayKey, SubArrayArea, SubArrayKeyHash> initialized;
+	unordered_map<SubArrayKey, SubArrayResult, SubArrayKeyHash> calculated;
+};
+
+#endif /* SUBARRAYCACHE_H_ */
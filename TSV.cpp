@@ -7,6 +7,7 @@
 
 #include "TSV.h"
 #include "formula.h"
+#include "Profiler.h"
 #include <cassert>
 
 TSV::TSV()
@@ -27,15 +28,17 @@ TSV::~TSV()
 {
 }
 
-void TSV::Initialize(TSV_type tsv_type, bool buffered)
+void TSV::Initialize(TSV_type tsv_type, int layers, bool buffered)
 {
+    PROFILE(profile_tsv_initialize);
     int num_gates_min = 1;
     double min_w_pmos = tech->pnSizeRatio * MIN_NMOS_SIZE * tech->featureSize;
     num_gates = 1;
 
-    cap = tech->capTSV[tsv_type];
-    res = tech->resTSV[tsv_type];
-    min_area = tech->areaTSV[tsv_type] * 1e-12;
+    const TSVParasitics &parasitics = tech->GetTSVParasitics(layers);
+    cap = parasitics.cap[tsv_type];
+    res = parasitics.res[tsv_type];
+    min_area = parasitics.area[tsv_type] * 1e-12;
 
     if (!buffered) {
         num_gates = 0;
@@ -82,6 +85,7 @@ void TSV::Initialize(TSV_type tsv_type, bool buffered)
 
 void TSV::CalculateArea()
 {
+    PROFILE(profile_tsv_area);
     //Obtain the driver chain area and leakage power for TSV
     double Vdd = tech->vdd;
     double cumulative_area = 0;
@@ -123,6 +127,7 @@ void TSV::CalculateArea()
 
 void TSV::CalculateLatencyAndPower(double _rampInputRead, double _rampInputWrite)
 {
+    PROFILE(profile_tsv_latency_power);
     assert(_rampInputRead != 0 && _rampInputWrite != 0);
 
     // Assume we are using the same TSV type/size/etc. we are just driving in a
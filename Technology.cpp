@@ -14,7 +14,7 @@
 Technology::Technology() {
 	// TODO Auto-generated constructor stub
 	initialized = false;
-    layerCount = 0;
+    minTSVLayer = 0;
 }
 
 Technology::~Technology() {
@@ -1813,9 +1813,6 @@ void Technology::Initialize(int _featureSizeInNano, DeviceRoadmap _deviceRoadmap
         tsv_liner_dielectric_constant[1][1] = 2.104;
     }
     // Note: CACTI3DD also has 16nm
-    
-    // Initialize to something -- will be changed in main loop later.
-    SetLayerCount(inputParameter, 2);
 
     /* For non-DRAM types vpp is equal to vdd. */
     if (_deviceRoadmap != EDRAM) {
@@ -1882,7 +1879,7 @@ void Technology::PrintProperty() {
 	cout << "TO-DO" << endl;
 }
 
-void Technology::InterpolateWith(Technology rhs, double _alpha) {
+void Technology::InterpolateWith(const Technology &rhs, double _alpha) {
 	if (featureSizeInNano != rhs.featureSizeInNano) {
 		vdd = (1 - _alpha) * vdd + _alpha * rhs.vdd;
 		vth = (1 - _alpha) * vth + _alpha * rhs.vth;
@@ -1918,14 +1915,14 @@ void Technology::InterpolateWith(Technology rhs, double _alpha) {
 	}
 }
 
-double Technology::tsv_resistance(double resistivity, double tsv_len, double tsv_diam, double tsv_contact_resistance)
+double Technology::tsv_resistance(double resistivity, double tsv_len, double tsv_diam, double tsv_contact_resistance) const
 {
 	double resistance;
 	resistance = resistivity * tsv_len / (3.1416 * (tsv_diam/2) * (tsv_diam/2)) + tsv_contact_resistance;
 	return(resistance);
 }
 
-double Technology::tsv_capacitance(double tsv_len, double tsv_diam, double tsv_pitch, double dielec_thickness, double liner_dielectric_constant, double depletion_width)
+double Technology::tsv_capacitance(double tsv_len, double tsv_diam, double tsv_pitch, double dielec_thickness, double liner_dielectric_constant, double depletion_width) const
 {
 	double self_cap, liner_cap, depletion_cap, lateral_coupling_cap, diagonal_coupling_cap, total_cap;
 	double diagonal_coupling_constant, lateral_coupling_constant;
@@ -1949,7 +1946,7 @@ double Technology::tsv_capacitance(double tsv_len, double tsv_diam, double tsv_p
 	return(total_cap);
 }
 
-double Technology::tsv_area(double tsv_pitch)
+double Technology::tsv_area(double tsv_pitch) const
 {
 	return(pow(tsv_pitch,2));
 }
@@ -1980,62 +1977,42 @@ TSV_type Technology::WireTypeToTSVType(int wiretype)
     return rv;
 }
 
-void Technology::SetLayerCount(InputParameter *inputParameter, int layers)
+void Technology::SetLayerRange(InputParameter *inputParameter, int minLayers, int maxLayers)
 {
-    double length_value;
-
-    if (layers == layerCount)
-        return;
-
-    //TSV aggressive, projected from ITRS
-    length_value = tsv_length[0][0] * layers;
-
-    //cout << "tsv_length " << length_value << " tsv_diameter " << tsv_diameter[0][0] << " tsv_contact_resistance " << tsv_contact_resistance[0][0] << std::endl;
-
-    tsv_parasitic_res[0][0] = tsv_resistance(BULK_CU_RESISTIVITY, length_value, tsv_diameter[0][0], tsv_contact_resistance[0][0]);
-    tsv_parasitic_cap[0][0] = tsv_capacitance(length_value, tsv_diameter[0][0], tsv_pitch[0][0], tsv_dielec_thickness[0][0], tsv_liner_dielectric_constant[0][0], tsv_depletion_width[0][0]);
-    tsv_occupation_area[0][0] = tsv_area(tsv_pitch[0][0]);
-
-    //TSV conservative, projected from ITRS
-    length_value = tsv_length[1][0] * layers;
-    tsv_parasitic_res[1][0] = tsv_resistance(BULK_CU_RESISTIVITY, length_value, tsv_diameter[1][0], tsv_contact_resistance[1][0]);
-    tsv_parasitic_cap[1][0] = tsv_capacitance(length_value, tsv_diameter[1][0], tsv_pitch[1][0], tsv_dielec_thickness[1][0], tsv_liner_dielectric_constant[1][0], tsv_depletion_width[1][0]);
-    tsv_occupation_area[1][0] = tsv_area(tsv_pitch[1][0]);
-
-    //TSV aggressive, industry reported
-    length_value = tsv_length[0][1] * layers;
-    tsv_parasitic_res[0][1] = tsv_resistance(BULK_CU_RESISTIVITY, length_value, tsv_diameter[0][1], tsv_contact_resistance[0][1]);
-    tsv_parasitic_cap[0][1] = tsv_capacitance(length_value, tsv_diameter[0][1], tsv_pitch[0][1], tsv_dielec_thickness[0][1], tsv_liner_dielectric_constant[0][1], tsv_depletion_width[0][1]);
-    tsv_occupation_area[0][1] = tsv_area(tsv_pitch[0][1]);
-
-    //TSV conservative, industry reported
-    length_value = tsv_length[1][1] * layers;
-    tsv_parasitic_res[1][1] = tsv_resistance(BULK_CU_RESISTIVITY, length_value, tsv_diameter[1][1], tsv_contact_resistance[1][1]);
-    tsv_parasitic_cap[1][1] = tsv_capacitance(length_value, tsv_diameter[1][1], tsv_pitch[1][1], tsv_dielec_thickness[1][1], tsv_liner_dielectric_constant[1][1], tsv_depletion_width[1][1]);
-    tsv_occupation_area[1][1] = tsv_area(tsv_pitch[1][1]);
-
-    //Finalize TSV parameters in tech pointer
+    // Local TSVs follow the local wire type, global TSVs the global wire type
     int local_ic_proj_type = WireTypeToTSVType(inputParameter->maxLocalWireType);
     int global_ic_proj_type = WireTypeToTSVType(inputParameter->maxGlobalWireType);
     int tsv_is_subarray_type = inputParameter->localTsvProjection;
     int tsv_os_bank_type = inputParameter->globalTsvProjection;
 
-    //for (int i=0; i < 2; i++) {
-    //    for (int j=0; j < 2; j++) {
-    //        cout << "res[" << i << "][" << j << "] = " << tsv_parasitic_res[i][j] << endl;
-    //        cout << "cap[" << i << "][" << j << "] = " << tsv_parasitic_cap[i][j] * 1e14 << "e-14" << endl;
-    //        cout << "area[" << i << "][" << j << "] = " << tsv_occupation_area[i][j] << endl;
-    //    }
-    //}
+    minTSVLayer = minLayers;
+    tsvParasitics.assign(maxLayers >= minLayers ? maxLayers - minLayers + 1 : 0, TSVParasitics());
+    for (int layers = minLayers; layers <= maxLayers; layers++) {
+        TSVParasitics &parasitics = tsvParasitics[layers - minLayers];
+        CalculateTSVParasitics(local_ic_proj_type, tsv_is_subarray_type, layers,
+                &parasitics.res[Fine], &parasitics.cap[Fine], &parasitics.area[Fine]);
+        CalculateTSVParasitics(global_ic_proj_type, tsv_os_bank_type, layers,
+                &parasitics.res[Coarse], &parasitics.cap[Coarse], &parasitics.area[Coarse]);
+    }
+}
 
-    resTSV[Fine] = tsv_parasitic_res[local_ic_proj_type][tsv_is_subarray_type];
-    capTSV[Fine] = tsv_parasitic_cap[local_ic_proj_type][tsv_is_subarray_type];
-    areaTSV[Fine] = tsv_occupation_area[local_ic_proj_type][tsv_is_subarray_type];
+const TSVParasitics & Technology::GetTSVParasitics(int layers) const
+{
+    if (layers < minTSVLayer || layers - minTSVLayer >= (int)tsvParasitics.size()) {
+        cout << "[Technology] Error: No TSV parasitics for " << layers << " layers!" << endl;
+        exit(-1);
+    }
+    return tsvParasitics[layers - minTSVLayer];
+}
 
-    resTSV[Coarse] = tsv_parasitic_res[global_ic_proj_type][tsv_os_bank_type];
-    capTSV[Coarse] = tsv_parasitic_cap[global_ic_proj_type][tsv_os_bank_type];
-    areaTSV[Coarse] = tsv_occupation_area[global_ic_proj_type][tsv_os_bank_type];
+// ic_proj_type: 0 - Aggressive, 1 - Conservative; tsv_proj_type: 0 - projected from ITRS, 1 - industry reported
+void Technology::CalculateTSVParasitics(int ic_proj_type, int tsv_proj_type, int layers, double *res, double *cap, double *area) const
+{
+    double length_value = tsv_length[ic_proj_type][tsv_proj_type] * layers;
 
-    layerCount = layers;
+    *res = tsv_resistance(BULK_CU_RESISTIVITY, length_value, tsv_diameter[ic_proj_type][tsv_proj_type], tsv_contact_resistance[ic_proj_type][tsv_proj_type]);
+    *cap = tsv_capacitance(length_value, tsv_diameter[ic_proj_type][tsv_proj_type], tsv_pitch[ic_proj_type][tsv_proj_type],
+            tsv_dielec_thickness[ic_proj_type][tsv_proj_type], tsv_liner_dielectric_constant[ic_proj_type][tsv_proj_type],
+            tsv_depletion_width[ic_proj_type][tsv_proj_type]);
+    *area = tsv_area(tsv_pitch[ic_proj_type][tsv_proj_type]);
 }
-
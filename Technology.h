@@ -10,6 +10,7 @@
 #define TECHNOLOGY_H_
 
 #include <iostream>
+#include <vector>
 #include "typedef.h"
 #include "InputParameter.h"
 #include "constant.h"
@@ -17,6 +18,13 @@
 
 using namespace std;
 
+/* Parasitics of a TSV through a stack of dies, for the local (Fine) and the global (Coarse) TSVs */
+struct TSVParasitics {
+	double cap[NUM_TSV_TYPES];		/* Unit: F */
+	double res[NUM_TSV_TYPES];		/* Unit: ohm */
+	double area[NUM_TSV_TYPES];		/* Unit: um^2 */
+};
+
 class Technology {
 public:
 	Technology();
@@ -25,7 +33,7 @@ public:
 	/* Functions */
 	void PrintProperty();
 	void Initialize(int _featureSizeInNano, DeviceRoadmap _deviceRoadmap, InputParameter *inputParameter);
-	void InterpolateWith(Technology rhs, double _alpha);
+	void InterpolateWith(const Technology &rhs, double _alpha);
 
 	/* Properties */
 	bool initialized;	/* Initialization flag */
@@ -57,19 +65,20 @@ public:
 
 	double capPolywire;	/* Poly wire capacitance, Unit: F/m */
 
-    double capTSV[NUM_TSV_TYPES];
-    double resTSV[NUM_TSV_TYPES];
-    double areaTSV[NUM_TSV_TYPES];
-
-    double tsv_resistance(double resistivity, double tsv_len, double tsv_diam, double tsv_contact_resistance);
-    double tsv_capacitance(double tsv_len, double tsv_diam, double tsv_pitch, double dielec_thickness, double liner_dielectric_constant, double depletion_width);
-    double tsv_area(double tsv_pitch);
-    TSV_type WireTypeToTSVType(int wiretype);
-    void SetLayerCount(InputParameter *inputParameter, int layers); /* Recalculate TSV parameters based on layer count */
+    double tsv_resistance(double resistivity, double tsv_len, double tsv_diam, double tsv_contact_resistance) const;
+    double tsv_capacitance(double tsv_len, double tsv_diam, double tsv_pitch, double dielec_thickness, double liner_dielectric_constant, double depletion_width) const;
+    double tsv_area(double tsv_pitch) const;
+    static TSV_type WireTypeToTSVType(int wiretype);
+    void SetLayerRange(InputParameter *inputParameter, int minLayers, int maxLayers); /* Precompute the TSV parasitics of every layer count in the range */
+    const TSVParasitics & GetTSVParasitics(int layers) const; /* The layer count must be in the range of SetLayerRange */
 
 private:
+    void CalculateTSVParasitics(int ic_proj_type, int tsv_proj_type, int layers, double *res, double *cap, double *area) const;
+
+    vector<TSVParasitics> tsvParasitics;	/* By layer count, from minTSVLayer */
+    int minTSVLayer;
+
     // TSV parameters from CACTI3DD model
-    int layerCount; 
     double tsv_pitch[NUMBER_INTERCONNECT_PROJECTION_TYPES][NUM_TSV_TYPES];
     double tsv_diameter[NUMBER_INTERCONNECT_PROJECTION_TYPES][NUM_TSV_TYPES];
     double tsv_length[NUMBER_INTERCONNECT_PROJECTION_TYPES][NUM_TSV_TYPES];
@@ -77,9 +86,6 @@ private:
     double tsv_contact_resistance[NUMBER_INTERCONNECT_PROJECTION_TYPES][NUM_TSV_TYPES];
     double tsv_depletion_width[NUMBER_INTERCONNECT_PROJECTION_TYPES][NUM_TSV_TYPES];
     double tsv_liner_dielectric_constant[NUMBER_INTERCONNECT_PROJECTION_TYPES][NUM_TSV_TYPES];
-    double tsv_parasitic_res[NUMBER_INTERCONNECT_PROJECTION_TYPES][NUM_TSV_TYPES];
-    double tsv_parasitic_cap[NUMBER_INTERCONNECT_PROJECTION_TYPES][NUM_TSV_TYPES];
-    double tsv_occupation_area[NUMBER_INTERCONNECT_PROJECTION_TYPES][NUM_TSV_TYPES];
 
 
 };
@@ -0,0 +1,93 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "TechnologyLibrary.h"
+
+bool TechnologyKey::operator<(const TechnologyKey &rhs) const {
+	if (featureSizeInNano != rhs.featureSizeInNano)
+		return featureSizeInNano < rhs.featureSizeInNano;
+	return deviceRoadmap < rhs.deviceRoadmap;
+}
+
+TechnologyLibrary::TechnologyLibrary() {
+	numHit = 0;
+	numMiss = 0;
+}
+
+TechnologyLibrary::~TechnologyLibrary() {
+	// TODO Auto-generated destructor stub
+}
+
+TechnologyLibrary & TechnologyLibrary::SharedLibrary() {
+	static TechnologyLibrary library;
+	return library;
+}
+
+void TechnologyLibrary::Load(Technology *technology, int _featureSizeInNano, DeviceRoadmap _deviceRoadmap,
+		InputParameter *inputParameter) {
+	lock_guard<mutex> lock(libraryMutex);
+	TechnologyKey key = MakeKey(_featureSizeInNano, _deviceRoadmap);
+	map<TechnologyKey, Technology>::iterator entry = interpolated.find(key);
+	if (entry == interpolated.end()) {
+		numMiss++;
+		Technology result = Node(_featureSizeInNano, _deviceRoadmap, inputParameter);
+		double alpha = 0;
+		int upperNode = UpperNode(_featureSizeInNano, &alpha);
+		if (upperNode > 0)
+			result.InterpolateWith(Node(upperNode, _deviceRoadmap, inputParameter), alpha);
+		entry = interpolated.insert(make_pair(key, result)).first;
+	} else {
+		numHit++;
+	}
+	*technology = entry->second;
+}
+
+int TechnologyLibrary::UpperNode(int _featureSizeInNano, double *alpha) {
+	*alpha = 0;
+	if (_featureSizeInNano > 200) {
+		// TO-DO: technology node > 200 nm
+		return 0;
+	} else if (_featureSizeInNano > 120) {	// 120 nm < technology node <= 200 nm
+		*alpha = (_featureSizeInNano - 120.0) / 60;
+		return 200;
+	} else if (_featureSizeInNano > 90) {	// 90 nm < technology node <= 120 nm
+		*alpha = (_featureSizeInNano - 90.0) / 30;
+		return 120;
+	} else if (_featureSizeInNano > 65) {	// 65 nm < technology node <= 90 nm
+		*alpha = (_featureSizeInNano - 65.0) / 25;
+		return 90;
+	} else if (_featureSizeInNano > 45) {	// 45 nm < technology node <= 65 nm
+		*alpha = (_featureSizeInNano - 45.0) / 20;
+		return 65;
+	} else if (_featureSizeInNano >= 32) {	// 32 nm < technology node <= 45 nm
+		*alpha = (_featureSizeInNano - 32.0) / 13;
+		return 45;
+	} else if (_featureSizeInNano >= 22) {	// 22 nm < technology node <= 32 nm
+		*alpha = (_featureSizeInNano - 22.0) / 10;
+		return 32;
+	} else {
+		//TO-DO: technology node < 22 nm
+		return 0;
+	}
+}
+
+TechnologyKey TechnologyLibrary::MakeKey(int _featureSizeInNano, DeviceRoadmap _deviceRoadmap) const {
+	TechnologyKey key;
+	key.featureSizeInNano = _featureSizeInNano;
+	key.deviceRoadmap = _deviceRoadmap;
+	return key;
+}
+
+const Technology & TechnologyLibrary::Node(int _featureSizeInNano, DeviceRoadmap _deviceRoadmap,
+		InputParameter *inputParameter) {
+	TechnologyKey key = MakeKey(_featureSizeInNano, _deviceRoadmap);
+	map<TechnologyKey, Technology>::iterator entry = nodes.find(key);
+	if (entry == nodes.end()) {
+		entry = nodes.insert(make_pair(key, Technology())).first;
+		entry->second.Initialize(_featureSizeInNano, _deviceRoadmap, inputParameter);
+	}
+	return entry->second;
+}
@@ -0,0 +1,56 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef TECHNOLOGYLIBRARY_H_
+#define TECHNOLOGYLIBRARY_H_
+
+#include <map>
+#include <mutex>
+#include "Technology.h"
+
+using namespace std;
+
+/* Everything that a technology depends on: the node and the roadmap. The current tables cover 300K to 400K,
+ * so the temperature is not part of it, and the TSVs are added by Technology::SetLayerRange after Load() */
+struct TechnologyKey {
+	int featureSizeInNano;
+	DeviceRoadmap deviceRoadmap;
+
+	bool operator<(const TechnologyKey &rhs) const;
+};
+
+/* Caches the technologies of a process, the ones that Technology::Initialize builds from its tables and
+ * the ones interpolated between two nodes of the tables. A run, a sweep over the nodes or a batch of runs
+ * in the same process pays Technology::Initialize and Technology::InterpolateWith once per technology,
+ * every Load() after that is a copy. The cache is shared by the threads */
+class TechnologyLibrary {
+public:
+	TechnologyLibrary();
+	virtual ~TechnologyLibrary();
+
+	/* Functions */
+	static TechnologyLibrary & SharedLibrary();	/* The library of the process */
+	void Load(Technology *technology, int _featureSizeInNano, DeviceRoadmap _deviceRoadmap,
+			InputParameter *inputParameter);	/* Interpolated with the next larger node of the tables */
+	static int UpperNode(int _featureSizeInNano, double *alpha);	/* The node to interpolate with, 0 if none */
+
+	/* Properties */
+	long long numHit;
+	long long numMiss;
+
+private:
+	TechnologyLibrary(const TechnologyLibrary &);
+	TechnologyLibrary & operator=(const TechnologyLibrary &);
+
+	TechnologyKey MakeKey(int _featureSizeInNano, DeviceRoadmap _deviceRoadmap) const;
+	const Technology & Node(int _featureSizeInNano, DeviceRoadmap _deviceRoadmap, InputParameter *inputParameter);
+
+	map<TechnologyKey, Technology> nodes;			/* From Technology::Initialize */
+	map<TechnologyKey, Technology> interpolated;	/* After Technology::InterpolateWith */
+	mutex libraryMutex;
+};
+
+#endif /* TECHNOLOGYLIBRARY_H_ */
@@ -9,6 +9,7 @@
 #include "global.h"
 #include "formula.h"
 #include "constant.h"
+#include "Profiler.h"
 #include <math.h>
 
 Wire::Wire() {
@@ -25,6 +26,7 @@ Wire::~Wire() {
 
 void Wire::Initialize(int _featureSizeInNano, WireType _wireType, WireRepeaterType _wireRepeaterType,
 		int _temperature, bool _isLowSwing) {
+	PROFILE(profile_wire_initialize);
 	if (initialized) {
 		/* reload the new input, clear the previous setting */
 		initialized = false;
@@ -496,6 +498,7 @@ void Wire::Initialize(int _featureSizeInNano, WireType _wireType, WireRepeaterTy
 
 
 void Wire::CalculateLatencyAndPower(double _wireLength, double *delay, double *dynamicEnergy, double *leakagePower) {
+	PROFILE(profile_wire_latency_power);
 	if (!initialized) {
 		cout << "[Wire] Error: Require initialization first!" << endl;
 	} else {
@@ -594,6 +597,8 @@ void Wire::CalculateLatencyAndPower(double _wireLength, double *delay, double *d
 				*(leakagePower) += 2 * tech->vdd * CalculateGateLeakage(NAND, 2, 2 * widthNmos, widthPmos, inputParameter->temperature, *tech);
 				*(leakagePower) *= 2;
 
+				if (senseAmp)
+					delete senseAmp;	/* The sense voltage follows the current cell */
 				senseAmp = new SenseAmp;
 				senseAmp->Initialize(1, false, cell->minSenseVoltage, 1 /* for test */);
 				senseAmp->CalculateRC();
@@ -654,6 +659,7 @@ void Wire::CalculateLatencyAndPower(double _wireLength, double *delay, double *d
 }
 
 void Wire::findOptimalRepeater() {
+	PROFILE(profile_wire_optimal_repeater);
 	/* Use minimum sized inverter */
 	double nmosSize = MIN_NMOS_SIZE * tech->featureSize;
 	double pmosSize = nmosSize * tech->pnSizeRatio;
@@ -671,34 +677,33 @@ void Wire::findOptimalRepeater() {
 }
 
 void Wire::findPenalizedRepeater(double _penalty) {
+	PROFILE(profile_wire_penalized_repeater);
+	/* Starting from the optimal repeater, the size is decreased in unit steps (down to the minimum buffer size)
+	 * as long as the delay stays within the penalty, at the optimal spacing. A smaller repeater always takes less
+	 * dynamic energy and leakage, and the delay only grows with every step because it is convex in the size and
+	 * the optimal repeater is within the penalty. So the last step within the penalty is found by bisection,
+	 * with a logarithmic number of delay evaluations, and it is the repeater that the former scan over the
+	 * spacing and the size chose: that scan did not reset the size for the next spacing, so it only ever tried
+	 * the optimal spacing. bench/RepeaterBench.cpp compares the two */
 	double targetDelay = getRepeatedWireUnitDelay() * (1 + _penalty);
-	double currentDynamicEnergy = getRepeatedWireUnitDynamicEnergy();
-	double currentLeakage = getRepeatedWireUnitLeakage();
-
-	double targetRepeaterSpacing = repeaterSpacing;
-	double targetRepeaterSize = repeaterSize;
-	double stepSpacing = 100e-6;	/* 100um */
-	double endSpacing = 4 * repeaterSpacing;
+	double optimalSize = repeaterSize;
 	double stepSize = 1;			/* minimum buffer size */
 	double endSize = 1;
 
-	double thisDelay, thisDynamicEnergy, thisLeakage;
-	/* Start finding the target repeated wire */
-	for (; repeaterSpacing <= endSpacing; repeaterSpacing += stepSpacing) {
-		for (; repeaterSize >= endSize; repeaterSize -= stepSize) {
-			thisDelay = getRepeatedWireUnitDelay();
-			thisDynamicEnergy = getRepeatedWireUnitDynamicEnergy();
-			thisLeakage = getRepeatedWireUnitLeakage();
-			if (thisDelay <= targetDelay && thisDynamicEnergy / currentDynamicEnergy + thisLeakage / currentLeakage < 2) {
-				currentDynamicEnergy = thisDynamicEnergy;
-				currentLeakage = thisLeakage;
-				targetRepeaterSpacing = repeaterSpacing;
-				targetRepeaterSize = repeaterSize;
-			}
-		}
+	if (!(optimalSize - stepSize >= endSize))
+		return;		/* No smaller repeater, or no repeater at all (NaN) */
+
+	long withinStep = 0;	/* The optimal repeater is within the penalty */
+	long beyondStep = (long)floor((optimalSize - endSize) / stepSize) + 1;	/* Smaller than the minimum buffer */
+	while (beyondStep - withinStep > 1) {
+		long step = withinStep + (beyondStep - withinStep) / 2;
+		repeaterSize = optimalSize - step * stepSize;
+		if (getRepeatedWireUnitDelay() <= targetDelay)
+			withinStep = step;
+		else
+			beyondStep = step;
 	}
-	repeaterSpacing = targetRepeaterSpacing;
-	repeaterSize = targetRepeaterSize;
+	repeaterSize = optimalSize - withinStep * stepSize;
 }
 
 double Wire::getRepeatedWireUnitDelay() {
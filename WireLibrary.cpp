@@ -0,0 +1,49 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#include "WireLibrary.h"
+
+WireLibrary::WireLibrary() {
+	initialized = false;
+	featureSizeInNano = 0;
+	temperature = 0;
+}
+
+WireLibrary::~WireLibrary() {
+	// TODO Auto-generated destructor stub
+}
+
+WireLibrary & WireLibrary::SharedLibrary() {
+	static WireLibrary library;
+	return library;
+}
+
+void WireLibrary::Initialize(int _featureSizeInNano, int _temperature) {
+	featureSizeInNano = _featureSizeInNano;
+	temperature = _temperature;
+
+	for (int type = 0; type < numWireType; type++) {
+		for (int repeaterType = 0; repeaterType < numWireRepeaterType; repeaterType++) {
+			entry[type][repeaterType][0].Initialize(featureSizeInNano, (WireType)type, (WireRepeaterType)repeaterType,
+					temperature, false);
+		}
+		/* Low swing is only supported without repeaters, the other entries stay uninitialized */
+		entry[type][repeated_none][1].Initialize(featureSizeInNano, (WireType)type, repeated_none, temperature, true);
+	}
+
+	initialized = true;
+}
+
+void WireLibrary::Load(Wire *wire, int _featureSizeInNano, WireType _wireType, WireRepeaterType _wireRepeaterType,
+		int _temperature, bool _isLowSwing) const {
+	if (!initialized || _featureSizeInNano != featureSizeInNano || _temperature != temperature
+			|| !entry[_wireType][_wireRepeaterType][_isLowSwing].initialized) {
+		/* Not in the library, Initialize also reports the unsupported combinations */
+		wire->Initialize(_featureSizeInNano, _wireType, _wireRepeaterType, _temperature, _isLowSwing);
+		return;
+	}
+	*wire = entry[_wireType][_wireRepeaterType][_isLowSwing];
+}
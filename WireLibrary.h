@@ -0,0 +1,44 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+
+#ifndef WIRELIBRARY_H_
+#define WIRELIBRARY_H_
+
+#include "Wire.h"
+
+using namespace std;
+
+const int numWireType = dram_wordline + 1;
+const int numWireRepeaterType = repeated_50 + 1;
+
+/* The wires of every (wire type, repeater type, low swing) combination, characterized once per run
+ * with Wire::Initialize, so that the geometry and the repeater searches are not redone every time the
+ * exploration switches the local or the global wire. Load() copies an entry into the wire that the
+ * components read. The entries are not changed after Initialize(), so all the threads share the library */
+class WireLibrary {
+public:
+	WireLibrary();
+	virtual ~WireLibrary();
+
+	/* Functions */
+	static WireLibrary & SharedLibrary();	/* The library of the run */
+	void Initialize(int _featureSizeInNano, int _temperature);	/* With the technology bound to the calling thread */
+	void Load(Wire *wire, int _featureSizeInNano, WireType _wireType, WireRepeaterType _wireRepeaterType,
+			int _temperature, bool _isLowSwing) const;	/* Same as wire->Initialize() with these parameters */
+
+	/* Properties */
+	bool initialized;
+	int featureSizeInNano;	/* Process feature size of the entries, Unit: nm */
+	int temperature;		/* Temperature of the entries, Unit: K */
+
+private:
+	WireLibrary(const WireLibrary &);
+	WireLibrary & operator=(const WireLibrary &);
+
+	Wire entry[numWireType][numWireRepeaterType][2];	/* The last index is isLowSwing */
+};
+
+#endif /* WIRELIBRARY_H_ */
@@ -0,0 +1,66 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+/* Counting replacement of the global operator new, linked into bench/destiny_bench only.
+ * The number of allocations of the whole run is printed to stderr when the program exits,
+ * where config_bench picks it up. */
+
+#include <new>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+
+static atomic<long long> numAllocation(0);
+
+static void * CountedAllocate(size_t size) {
+	numAllocation.fetch_add(1, memory_order_relaxed);
+	void *memory = malloc(size ? size : 1);
+	if (!memory)
+		throw bad_alloc();
+	return memory;
+}
+
+void * operator new(size_t size) {
+	return CountedAllocate(size);
+}
+
+void * operator new[](size_t size) {
+	return CountedAllocate(size);
+}
+
+void * operator new(size_t size, const nothrow_t &) noexcept {
+	numAllocation.fetch_add(1, memory_order_relaxed);
+	return malloc(size ? size : 1);
+}
+
+void * operator new[](size_t size, const nothrow_t &) noexcept {
+	numAllocation.fetch_add(1, memory_order_relaxed);
+	return malloc(size ? size : 1);
+}
+
+void operator delete(void *memory) noexcept {
+	free(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+	free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+	free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept {
+	free(memory);
+}
+
+/* Printed when the static objects are destroyed, after main returns or exit is called */
+static struct AllocationReport {
+	~AllocationReport() {
+		fprintf(stderr, "allocations = %lld\n", numAllocation.load());
+	}
+} allocationReport;
@@ -0,0 +1,368 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+/* Benchmark of the whole tool over the configuration files, run by make bench.
+ * Every config is run with its own optimization target (single) and with the full exploration (full),
+ * each run in a child process from a copy of the config in a temporary directory, with the cell files
+ * of the copy pointing back to the config directory, so the config directory is never written. For every run it
+ * records the wall time, the designs per second (numDesigns of the output over the wall time), the
+ * peak RSS of the child and the number of allocations, which bench/destiny_bench prints when it exits.
+ * The results are written as csv, and compared with a baseline in the same format if there is one:
+ * a run that is slower, larger or allocates more than the baseline by more than the tolerance is a
+ * regression, and the exit status is 1.
+ *
+ * Usage: config_bench [-d <config dir>] [-o <results file>] [-b <baseline file>] [-n] [-m single|full|both]
+ *                     [-c <config name>]... [-t <tolerance>] <destiny binary>
+ *   -d  directory of the configs, config by default, the files starting with _ are skipped
+ *   -o  results file, bench/results.csv by default
+ *   -b  baseline file, bench/baseline.csv by default, no comparison if it does not exist (make bench-baseline)
+ *   -n  no comparison, to write a new baseline
+ *   -m  modes to run, both by default
+ *   -c  only run this config (without .cfg), can be repeated
+ *   -t  relative tolerance of the comparison, 0.1 by default */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <climits>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+using namespace std;
+
+#define BENCH_CONFIG_NAME	"_bench"	/* The copy of the config that is run, and its output file */
+
+/* The temporary directory of the runs and the files in it, kept as C strings so that the signal
+ * handler can remove them */
+char workDir[PATH_MAX];
+char workFiles[3][PATH_MAX + 16];
+volatile pid_t runningChild = 0;	/* The run in progress, 0 if none */
+
+void RemoveWorkFiles() {
+	for (int i = 0; i < 3; i++)
+		unlink(workFiles[i]);
+}
+
+/* An interrupted run does not leave its files behind */
+void InterruptHandler(int signal) {
+	if (runningChild > 0) {
+		kill(runningChild, SIGKILL);
+		waitpid(runningChild, NULL, 0);
+	}
+	RemoveWorkFiles();
+	rmdir(workDir);
+	_exit(128 + signal);
+}
+
+struct BenchResult {
+	string config;
+	string mode;
+	double seconds;
+	long long numDesigns;
+	double designsPerSecond;
+	long peakRss;			/* Unit: KB */
+	long long numAllocation;
+	bool failed;
+};
+
+/* Sum of the values after every occurrence of key in the output, 0 if there is none */
+long long SumValues(const string &output, const string &key) {
+	long long sum = 0;
+	size_t position = 0;
+	while ((position = output.find(key, position)) != string::npos) {
+		position += key.size();
+		sum += atoll(output.c_str() + position);
+	}
+	return sum;
+}
+
+/* Copy the config to BENCH_CONFIG_NAME.cfg in the work directory, with the full exploration if full is set.
+ * The cell files are relative to the config directory, so they are made absolute */
+bool WriteConfig(const string &configDir, const string &config, bool full) {
+	ifstream input((configDir + "/" + config + ".cfg").c_str());
+	ofstream output(workFiles[0], ofstream::out | ofstream::trunc);
+	if (!input.is_open() || !output.is_open())
+		return false;
+	string line;
+	bool targetFound = false;
+	while (getline(input, line)) {
+		if (full && !strncmp("-OptimizationTarget", line.c_str(), strlen("-OptimizationTarget"))) {
+			line = "-OptimizationTarget: Full";
+			targetFound = true;
+		}
+		char cellFile[PATH_MAX];
+		if (sscanf(line.c_str(), "-MemoryCellInputFile: %s", cellFile) == 1 && cellFile[0] != '/')
+			line = "-MemoryCellInputFile: " + configDir + "/" + cellFile;
+		output << line << endl;
+	}
+	if (full && !targetFound)
+		output << "-OptimizationTarget: Full" << endl;
+	return true;
+}
+
+/* Run the binary on BENCH_CONFIG_NAME.cfg in the work directory */
+BenchResult Run(const string &binary, const string &configDir, const string &config, const string &mode) {
+	BenchResult result;
+	result.config = config;
+	result.mode = mode;
+	result.seconds = result.designsPerSecond = 0;
+	result.numDesigns = result.numAllocation = 0;
+	result.peakRss = 0;
+	result.failed = true;
+
+	if (!WriteConfig(configDir, config, mode == "full"))
+		return result;
+
+	int pipeEnds[2];
+	if (pipe(pipeEnds))
+		return result;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	pid_t child = fork();
+	if (child == 0) {
+		dup2(pipeEnds[1], STDOUT_FILENO);
+		dup2(pipeEnds[1], STDERR_FILENO);
+		close(pipeEnds[0]);
+		close(pipeEnds[1]);
+		if (chdir(workDir) == 0)
+			execl(binary.c_str(), binary.c_str(), BENCH_CONFIG_NAME ".cfg", (char *)NULL);
+		_exit(127);
+	}
+	runningChild = child;
+	close(pipeEnds[1]);
+	string output;
+	char buffer[4096];
+	ssize_t size;
+	while ((size = read(pipeEnds[0], buffer, sizeof(buffer))) > 0)
+		output.append(buffer, size);
+	close(pipeEnds[0]);
+
+	int status = 0;
+	struct rusage usage;
+	if (child < 0 || wait4(child, &status, 0, &usage) < 0) {
+		runningChild = 0;
+		return result;
+	}
+	runningChild = 0;
+	result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	result.peakRss = usage.ru_maxrss;
+	result.numDesigns = SumValues(output, "numDesigns = ");
+	result.numAllocation = SumValues(output, "allocations = ");
+	result.designsPerSecond = result.seconds > 0 ? result.numDesigns / result.seconds : 0;
+	result.failed = !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+	if (result.failed)
+		cout << output.substr(output.size() > 2000 ? output.size() - 2000 : 0) << endl;
+
+	RemoveWorkFiles();
+	return result;
+}
+
+/* The results of a previous run, by config and mode */
+map<string, BenchResult> ReadResults(const string &fileName) {
+	map<string, BenchResult> results;
+	ifstream input(fileName.c_str());
+	string line;
+	getline(input, line);	/* header */
+	while (getline(input, line)) {
+		BenchResult result;
+		string field;
+		istringstream fields(line);
+		getline(fields, result.config, ',');
+		getline(fields, result.mode, ',');
+		getline(fields, field, ',');
+		result.seconds = atof(field.c_str());
+		getline(fields, field, ',');
+		result.numDesigns = atoll(field.c_str());
+		getline(fields, field, ',');
+		result.designsPerSecond = atof(field.c_str());
+		getline(fields, field, ',');
+		result.peakRss = atol(field.c_str());
+		getline(fields, field, ',');
+		result.numAllocation = atoll(field.c_str());
+		getline(fields, field, ',');
+		result.failed = (field == "failed");
+		results[result.config + "," + result.mode] = result;
+	}
+	return results;
+}
+
+bool Exceeds(double value, double baseline, double tolerance) {
+	return baseline > 0 && value > baseline * (1 + tolerance);
+}
+
+int main(int argc, char *argv[])
+{
+	string configDir = "config";
+	string resultFileName = "bench/results.csv";
+	string baselineFileName = "bench/baseline.csv";
+	string modes = "both";
+	vector<string> configs;
+	double tolerance = 0.1;
+	bool compare = true;
+	string binary;
+	for (int argIdx = 1; argIdx < argc; argIdx++) {
+		string arg = argv[argIdx];
+		if (arg == "-d" && argIdx + 1 < argc) {
+			configDir = argv[++argIdx];
+		} else if (arg == "-o" && argIdx + 1 < argc) {
+			resultFileName = argv[++argIdx];
+		} else if (arg == "-b" && argIdx + 1 < argc) {
+			baselineFileName = argv[++argIdx];
+		} else if (arg == "-n") {
+			compare = false;
+		} else if (arg == "-m" && argIdx + 1 < argc) {
+			modes = argv[++argIdx];
+		} else if (arg == "-c" && argIdx + 1 < argc) {
+			configs.push_back(argv[++argIdx]);
+		} else if (arg == "-t" && argIdx + 1 < argc) {
+			tolerance = atof(argv[++argIdx]);
+		} else if (binary.empty() && arg[0] != '-') {
+			binary = arg;
+		} else {
+			cout << "[ERROR] Unknown option: " << arg << endl;
+			exit(-1);
+		}
+	}
+	if (binary.empty() || (modes != "single" && modes != "full" && modes != "both")) {
+		cout << "Usage: " << argv[0] << " [-d <config dir>] [-o <results file>] [-b <baseline file>] [-n] [-m single|full|both]"
+				<< " [-c <config name>]... [-t <tolerance>] <destiny binary>" << endl;
+		exit(-1);
+	}
+	/* The binary is started from the config directory */
+	char *binaryPath = realpath(binary.c_str(), NULL);
+	if (!binaryPath) {
+		cout << "[ERROR] Cannot find " << binary << endl;
+		exit(-1);
+	}
+	binary = binaryPath;
+	free(binaryPath);
+	/* The copies of the configs refer to the cell files of the config directory */
+	char *configPath = realpath(configDir.c_str(), NULL);
+	if (!configPath) {
+		cout << "[ERROR] Cannot open " << configDir << endl;
+		exit(-1);
+	}
+	configDir = configPath;
+	free(configPath);
+
+	if (configs.empty()) {
+		DIR *dir = opendir(configDir.c_str());
+		if (!dir) {
+			cout << "[ERROR] Cannot open " << configDir << endl;
+			exit(-1);
+		}
+		struct dirent *entry;
+		while ((entry = readdir(dir)) != NULL) {
+			string name = entry->d_name;
+			if (name.size() > 4 && name.compare(name.size() - 4, 4, ".cfg") == 0 && name[0] != '_')
+				configs.push_back(name.substr(0, name.size() - 4));
+		}
+		closedir(dir);
+		sort(configs.begin(), configs.end());
+	}
+
+	map<string, BenchResult> baseline;
+	if (compare)
+		baseline = ReadResults(baselineFileName);
+	if (!baseline.empty())
+		cout << "Comparing with " << baselineFileName << ", tolerance " << tolerance * 100 << "%" << endl;
+	else if (compare)
+		cout << "[WARNING] No baseline in " << baselineFileName << ", the results are not compared"
+				<< " (make bench-baseline writes one)" << endl;
+
+
+	ofstream resultFile(resultFileName.c_str(), ofstream::out | ofstream::trunc);
+	if (!resultFile.is_open()) {
+		cout << "[ERROR] Cannot open " << resultFileName << endl;
+		exit(-1);
+	}
+	resultFile << "config,mode,seconds,designs,designsPerSecond,peakRssKB,allocations,status" << endl;
+
+	const char *tempDir = getenv("TMPDIR");
+	snprintf(workDir, sizeof(workDir), "%s/destiny_bench.XXXXXX", (tempDir && tempDir[0]) ? tempDir : "/tmp");
+	if (!mkdtemp(workDir)) {
+		cout << "[ERROR] Cannot create a temporary directory in " << ((tempDir && tempDir[0]) ? tempDir : "/tmp") << endl;
+		exit(-1);
+	}
+	const char *extensions[] = {".cfg", ".csv", ".bin"};
+	for (int i = 0; i < 3; i++)
+		snprintf(workFiles[i], sizeof(workFiles[i]), "%s/" BENCH_CONFIG_NAME "%s", workDir, extensions[i]);
+	signal(SIGINT, InterruptHandler);
+	signal(SIGTERM, InterruptHandler);
+	signal(SIGHUP, InterruptHandler);
+
+	cout << left << setw(24) << "Config" << setw(8) << "Mode" << right << setw(10) << "Time (s)" << setw(14) << "Designs/s"
+			<< setw(14) << "Peak RSS (KB)" << setw(14) << "Allocations" << "  Baseline" << endl;
+	int numRegression = 0, numFailure = 0;
+	for (int c = 0; c < (int)configs.size(); c++) {
+		for (int m = 0; m < 2; m++) {
+			string mode = m == 0 ? "single" : "full";
+			if (modes != "both" && modes != mode)
+				continue;
+			cout << left << setw(24) << configs[c] << setw(8) << mode << flush;
+			BenchResult result = Run(binary, configDir, configs[c], mode);
+			resultFile << result.config << "," << result.mode << "," << result.seconds << "," << result.numDesigns << ","
+					<< result.designsPerSecond << "," << result.peakRss << "," << result.numAllocation << ","
+					<< (result.failed ? "failed" : "ok") << endl;
+
+			cout << right << fixed << setprecision(2)
+					<< setw(10) << result.seconds << setprecision(0) << setw(14) << result.designsPerSecond
+					<< setw(14) << result.peakRss << setw(14) << result.numAllocation;
+			cout.unsetf(ios_base::floatfield);
+			if (result.failed) {
+				numFailure++;
+				cout << "  FAILED" << endl;
+				continue;
+			}
+			map<string, BenchResult>::const_iterator base = baseline.find(result.config + "," + result.mode);
+			if (base == baseline.end() || base->second.failed) {
+				cout << endl;
+				continue;
+			}
+			cout << setprecision(3) << "  time x" << result.seconds / base->second.seconds;
+			bool regression = false;
+			if (Exceeds(result.seconds, base->second.seconds, tolerance)) {
+				cout << " slower";
+				regression = true;
+			}
+			if (Exceeds(result.peakRss, base->second.peakRss, tolerance)) {
+				cout << " larger";
+				regression = true;
+			}
+			if (Exceeds(result.numAllocation, base->second.numAllocation, tolerance)) {
+				cout << " more allocations";
+				regression = true;
+			}
+			if (result.numDesigns != base->second.numDesigns)
+				cout << " (" << base->second.numDesigns << " designs in the baseline)";
+			if (regression) {
+				cout << "  REGRESSION";
+				numRegression++;
+			}
+			cout << setprecision(6) << endl;
+		}
+	}
+	resultFile.close();
+	rmdir(workDir);
+	cout << "Results written to " << resultFileName << endl;
+
+	if (numFailure > 0)
+		cout << numFailure << " runs failed" << endl;
+	if (numRegression > 0)
+		cout << numRegression << " regressions against " << baselineFileName << endl;
+	return (numFailure > 0 || numRegression > 0) ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+/* Microbenchmark of the device formulas in formula.cpp.
+ * It compares passing Technology by value (a copy of the current tables and the TSV arrays
+ * per call) with passing it by const reference, and reports the average evaluation time of
+ * the mat-level design points of one bank organization.
+ *
+ * Usage: formula_bench <config file> [number of formula calls] */
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <chrono>
+#include "InputParameter.h"
+#include "Technology.h"
+#include "MemCell.h"
+#include "Wire.h"
+#include "WireLibrary.h"
+#include "BankWithHtree.h"
+#include "BankWithoutHtree.h"
+#include "BankPool.h"
+#include "formula.h"
+#include "macros.h"
+
+using namespace std;
+
+thread_local InputParameter *inputParameter;
+thread_local Technology *tech;
+thread_local Technology *devtech;
+thread_local MemCell *cell;
+thread_local Wire *localWire;
+thread_local Wire *globalWire;
+MemCell **sweepCells;
+
+/* The formula API before it took Technology by const reference */
+__attribute__((noinline)) double CalculateGateCapByValue(double width, Technology tech) {
+	return CalculateGateCap(width, tech);
+}
+
+__attribute__((noinline)) double CalculateOnResistanceByValue(double width, int type, double temperature, Technology tech) {
+	return CalculateOnResistance(width, type, temperature, tech);
+}
+
+double ElapsedSecond(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		cout << "Usage: " << argv[0] << " <config file> [number of formula calls]" << endl;
+		exit(-1);
+	}
+	long numCall = (argc > 2) ? atol(argv[2]) : 1000000;
+
+	inputParameter = new InputParameter();
+	RESTORE_SEARCH_SIZE;
+	inputParameter->ReadInputParameterFromFile(argv[1]);
+
+	tech = new Technology();
+	tech->Initialize(inputParameter->processNode, inputParameter->deviceRoadmap, inputParameter);
+	tech->SetLayerRange(inputParameter, inputParameter->minStackLayer, inputParameter->maxStackLayer);
+	devtech = tech;
+	cell = new MemCell();
+	cell->ReadCellFromFile(inputParameter->fileMemCell[0]);
+	cell->ApplyPVT();
+	WireLibrary::SharedLibrary().Initialize(inputParameter->processNode, inputParameter->temperature);
+	localWire = new Wire();
+	globalWire = new Wire();
+	INITIAL_BASIC_WIRE;
+
+	cout << fixed << setprecision(3);
+	cout << "sizeof(Technology) = " << sizeof(Technology) << " bytes" << endl;
+
+	/* Formula calls */
+	double width = 4 * tech->featureSize;
+	volatile double sink = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (long i = 0; i < numCall; i++) {
+		sink = sink + CalculateGateCapByValue(width, *tech);
+		sink = sink + CalculateOnResistanceByValue(width, NMOS, inputParameter->temperature, *tech);
+	}
+	double byValue = ElapsedSecond(start) / numCall / 2;
+
+	start = chrono::steady_clock::now();
+	for (long i = 0; i < numCall; i++) {
+		sink = sink + CalculateGateCap(width, *tech);
+		sink = sink + CalculateOnResistance(width, NMOS, inputParameter->temperature, *tech);
+	}
+	double byReference = ElapsedSecond(start) / numCall / 2;
+
+	cout << "Formula call, Technology by value     : " << byValue * 1e9 << "ns" << endl;
+	cout << "Formula call, Technology by reference : " << byReference * 1e9 << "ns" << endl;
+	cout << "Speedup per formula call              : " << byValue / byReference << "x" << endl;
+
+	/* Design points of the smallest bank organization */
+	int numRowMat = inputParameter->minNumRowMat, numColumnMat = inputParameter->minNumColumnMat;
+	int numActiveMatPerRow = MIN(numColumnMat, inputParameter->minNumActiveMatPerRow);
+	int numActiveMatPerColumn = MIN(numRowMat, inputParameter->minNumActiveMatPerColumn);
+	int stackedDieCount = inputParameter->minStackLayer;
+	int numRowSubarray, numColumnSubarray, numActiveSubarrayPerRow, numActiveSubarrayPerColumn;
+	int muxSenseAmp, muxOutputLev1, muxOutputLev2, numRowPerSet;
+	int areaOptimizationLevel;
+	int partitionGranularity = inputParameter->partitionGranularity;
+	long long capacity = (long long)inputParameter->capacity * 8;
+	long blockSize = inputParameter->wordWidth;
+	int associativity = 1;
+	EvalContext *evalContext = NULL;
+	Bank *dataBank;
+	long numDesign = 0;
+
+	start = chrono::steady_clock::now();
+	BIGFOR_MAT {
+		if (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) == 0)
+			continue;
+		CALCULATE(dataBank, MemoryType::data);
+		numDesign++;
+		BankPool::ThreadPool().Release(dataBank);
+	}
+	double perDesign = ElapsedSecond(start) / MAX(numDesign, 1L);
+
+	cout << "Design points evaluated               : " << numDesign << endl;
+	cout << "Evaluation time per design point      : " << perDesign * 1e6 << "us" << endl;
+
+	return 0;
+}
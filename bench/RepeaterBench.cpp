@@ -0,0 +1,136 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+/* Check and microbenchmark of Wire::findPenalizedRepeater.
+ * For every technology node, device roadmap, temperature, wire type and delay penalty, the repeater
+ * (size and spacing) that Wire::findPenalizedRepeater chooses is compared with the one of the former
+ * nested scan over the spacing and the size, which is kept here as the reference. Both start from the
+ * optimal repeater of the same wire. The exit status is 1 if any repeater differs.
+ *
+ * Usage: repeater_bench [number of repetitions for the timing] */
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include "InputParameter.h"
+#include "Technology.h"
+#include "MemCell.h"
+#include "Wire.h"
+
+using namespace std;
+
+thread_local InputParameter *inputParameter;
+thread_local Technology *tech;
+thread_local Technology *devtech;
+thread_local MemCell *cell;
+thread_local Wire *localWire;
+thread_local Wire *globalWire;
+MemCell **sweepCells;
+
+/* Wire::findPenalizedRepeater before the bisection */
+void ScanPenalizedRepeater(Wire &wire, double _penalty) {
+	double targetDelay = wire.getRepeatedWireUnitDelay() * (1 + _penalty);
+	double currentDynamicEnergy = wire.getRepeatedWireUnitDynamicEnergy();
+	double currentLeakage = wire.getRepeatedWireUnitLeakage();
+
+	double targetRepeaterSpacing = wire.repeaterSpacing;
+	double targetRepeaterSize = wire.repeaterSize;
+	double stepSpacing = 100e-6;	/* 100um */
+	double endSpacing = 4 * wire.repeaterSpacing;
+	double stepSize = 1;			/* minimum buffer size */
+	double endSize = 1;
+
+	double thisDelay, thisDynamicEnergy, thisLeakage;
+	for (; wire.repeaterSpacing <= endSpacing; wire.repeaterSpacing += stepSpacing) {
+		for (; wire.repeaterSize >= endSize; wire.repeaterSize -= stepSize) {
+			thisDelay = wire.getRepeatedWireUnitDelay();
+			thisDynamicEnergy = wire.getRepeatedWireUnitDynamicEnergy();
+			thisLeakage = wire.getRepeatedWireUnitLeakage();
+			if (thisDelay <= targetDelay && thisDynamicEnergy / currentDynamicEnergy + thisLeakage / currentLeakage < 2) {
+				currentDynamicEnergy = thisDynamicEnergy;
+				currentLeakage = thisLeakage;
+				targetRepeaterSpacing = wire.repeaterSpacing;
+				targetRepeaterSize = wire.repeaterSize;
+			}
+		}
+	}
+	wire.repeaterSpacing = targetRepeaterSpacing;
+	wire.repeaterSize = targetRepeaterSize;
+}
+
+/* Equal, or both NaN as for dram_wordline */
+bool SameValue(double a, double b) {
+	return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+double ElapsedSecond(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+	int numRepetition = (argc > 1) ? atoi(argv[1]) : 20;
+	const int featureSizes[] = {200, 120, 90, 65, 45, 32, 22};
+	const DeviceRoadmap roadmaps[] = {HP, LSTP, LOP, EDRAM};
+	const int temperatures[] = {300, 350, 400};
+	const double penalties[] = {0.05, 0.10, 0.20, 0.30, 0.40, 0.50};
+	const char *roadmapNames[] = {"HP", "LSTP", "LOP", "EDRAM"};
+
+	inputParameter = new InputParameter();
+	int numCase = 0, numMismatch = 0;
+	double scanSecond = 0, searchSecond = 0;
+
+	for (int f = 0; f < (int)(sizeof(featureSizes) / sizeof(featureSizes[0])); f++)
+	for (int r = 0; r < (int)(sizeof(roadmaps) / sizeof(roadmaps[0])); r++)
+	for (int t = 0; t < (int)(sizeof(temperatures) / sizeof(temperatures[0])); t++) {
+		if (roadmaps[r] == EDRAM && featureSizes[f] > 90)
+			continue;	/* No EDRAM roadmap above 90nm */
+		inputParameter->temperature = temperatures[t];
+		tech = new Technology();
+		tech->Initialize(featureSizes[f], roadmaps[r], inputParameter);
+		devtech = tech;
+		for (int type = local_aggressive; type <= dram_wordline; type++) {
+			Wire optimal;
+			optimal.Initialize(featureSizes[f], (WireType)type, repeated_opt, temperatures[t], false);
+			for (int p = 0; p < (int)(sizeof(penalties) / sizeof(penalties[0])); p++) {
+				Wire scanned, searched;
+				chrono::steady_clock::time_point start = chrono::steady_clock::now();
+				for (int i = 0; i < numRepetition; i++) {
+					scanned = optimal;
+					ScanPenalizedRepeater(scanned, penalties[p]);
+				}
+				scanSecond += ElapsedSecond(start);
+				start = chrono::steady_clock::now();
+				for (int i = 0; i < numRepetition; i++) {
+					searched = optimal;
+					searched.findPenalizedRepeater(penalties[p]);
+				}
+				searchSecond += ElapsedSecond(start);
+
+				numCase++;
+				if (!SameValue(scanned.repeaterSize, searched.repeaterSize)
+						|| !SameValue(scanned.repeaterSpacing, searched.repeaterSpacing)) {
+					numMismatch++;
+					cout << setprecision(17) << "[MISMATCH] " << featureSizes[f] << "nm " << roadmapNames[r] << " "
+							<< temperatures[t] << "K wire type " << type << " penalty " << penalties[p]
+							<< ": scan size " << scanned.repeaterSize << " spacing " << scanned.repeaterSpacing
+							<< ", findPenalizedRepeater size " << searched.repeaterSize << " spacing "
+							<< searched.repeaterSpacing << endl;
+				}
+			}
+		}
+		delete tech;
+	}
+
+	cout << fixed << setprecision(3);
+	cout << "Repeaters compared                  : " << numCase << endl;
+	cout << "Repeaters that differ               : " << numMismatch << endl;
+	cout << "Former scan, per repeater           : " << scanSecond / numCase / numRepetition * 1e6 << "us" << endl;
+	cout << "findPenalizedRepeater, per repeater : " << searchSecond / numCase / numRepetition * 1e6 << "us" << endl;
+	cout << "Speedup                             : " << scanSecond / searchSecond << "x" << endl;
+	return numMismatch > 0 ? 1 : 0;
+}
@@ -0,0 +1,140 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+/* Microbenchmark of the subarray model, per cell type.
+ * For every cell file of every config file, a fixed set of subarray organizations is initialized and
+ * evaluated (SubArray::Initialize, CalculateArea, CalculateLatency and CalculatePower) as the mat does
+ * it. It reports the average time per subarray and a checksum of the results, so the same binary built
+ * before and after a change to the subarray model shows both the gain and that the results are unchanged.
+ *
+ * Usage: subarray_bench <config file>... [-r number of repetitions] */
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <vector>
+#include "InputParameter.h"
+#include "Technology.h"
+#include "MemCell.h"
+#include "Wire.h"
+#include "WireLibrary.h"
+#include "SubArray.h"
+#include "macros.h"
+
+using namespace std;
+
+thread_local InputParameter *inputParameter;
+thread_local Technology *tech;
+thread_local Technology *devtech;
+thread_local MemCell *cell;
+thread_local Wire *localWire;
+thread_local Wire *globalWire;
+MemCell **sweepCells;
+
+const char *cellTypeNames[] = {"SRAM", "DRAM", "eDRAM", "MRAM", "PCRAM", "memristor", "FBRAM", "SLCNAND", "MLCNAND"};
+
+/* One subarray organization */
+struct SubArrayDesign {
+	long long numRow;
+	long long numColumn;
+	int muxSenseAmp;
+	int muxOutputLev1;
+};
+
+double ElapsedSecond(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/* Evaluates every design once, returns the checksum of the valid ones */
+double EvaluateDesigns(const vector<SubArrayDesign> &designs, int *numValid) {
+	double checksum = 0;
+	*numValid = 0;
+	for (int i = 0; i < (int)designs.size(); i++) {
+		SubArray subarray;
+		subarray.Initialize(designs[i].numRow, designs[i].numColumn, false, true, designs[i].muxSenseAmp,
+				inputParameter->internalSensing, designs[i].muxOutputLev1, 1, latency_first,
+				inputParameter->monolithicStackCount);
+		if (subarray.invalid)
+			continue;
+		subarray.CalculateArea();
+		subarray.CalculateLatency(1e20);
+		subarray.CalculatePower();
+		checksum += subarray.area + subarray.readLatency + subarray.writeLatency + subarray.readDynamicEnergy
+				+ subarray.writeDynamicEnergy + subarray.leakage;
+		(*numValid)++;
+	}
+	return checksum;
+}
+
+int main(int argc, char *argv[])
+{
+	int numRepetition = 20;
+	vector<const char *> configFiles;
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-r") && i + 1 < argc)
+			numRepetition = atoi(argv[++i]);
+		else
+			configFiles.push_back(argv[i]);
+	}
+	if (configFiles.empty() || numRepetition < 1) {
+		cout << "Usage: " << argv[0] << " <config file>... [-r number of repetitions]" << endl;
+		exit(-1);
+	}
+
+	/* Powers of two from 64 to 2048 rows and columns, with the first levels of column muxing */
+	vector<SubArrayDesign> designs;
+	for (long long numRow = 64; numRow <= 2048; numRow *= 2)
+		for (long long numColumn = 64; numColumn <= 2048; numColumn *= 2)
+			for (int muxSenseAmp = 1; muxSenseAmp <= 8; muxSenseAmp *= 2)
+				for (int muxOutputLev1 = 1; muxOutputLev1 <= 2; muxOutputLev1 *= 2) {
+					SubArrayDesign design = {numRow, numColumn, muxSenseAmp, muxOutputLev1};
+					designs.push_back(design);
+				}
+
+	cout << left << setw(28) << "Cell file" << setw(11) << "Cell type" << right << setw(8) << "Valid"
+			<< setw(15) << "us/subarray" << setw(26) << "Checksum" << endl;
+	for (int c = 0; c < (int)configFiles.size(); c++) {
+		inputParameter = new InputParameter();
+		RESTORE_SEARCH_SIZE;
+		inputParameter->ReadInputParameterFromFile(configFiles[c]);
+
+		tech = new Technology();
+		tech->Initialize(inputParameter->processNode, inputParameter->deviceRoadmap, inputParameter);
+		tech->SetLayerRange(inputParameter, inputParameter->minStackLayer, inputParameter->maxStackLayer);
+		devtech = tech;
+		WireLibrary::SharedLibrary().Initialize(inputParameter->processNode, inputParameter->temperature);
+		localWire = new Wire();
+		globalWire = new Wire();
+		INITIAL_BASIC_WIRE;
+
+		for (int cellIdx = 0; cellIdx < (int)inputParameter->fileMemCell.size(); cellIdx++) {
+			cell = new MemCell();
+			cell->ReadCellFromFile(inputParameter->fileMemCell[cellIdx]);
+			cell->ApplyPVT();
+
+			int numValid = 0;
+			double checksum = EvaluateDesigns(designs, &numValid);	/* warm up */
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			for (int i = 0; i < numRepetition; i++)
+				EvaluateDesigns(designs, &numValid);
+			double perSubarray = ElapsedSecond(start) / numRepetition / designs.size();
+
+			string cellFile = inputParameter->fileMemCell[cellIdx];
+			cellFile = cellFile.substr(cellFile.find_last_of('/') + 1);
+			cout << left << setw(28) << cellFile << setw(11) << cellTypeNames[cell->memCellType] << right
+					<< setw(8) << numValid << setw(15) << fixed << setprecision(3) << perSubarray * 1e6
+					<< setw(26) << scientific << setprecision(17) << checksum << endl;
+			delete cell;
+		}
+
+		delete localWire;
+		delete globalWire;
+		delete tech;
+		delete inputParameter;
+	}
+	return 0;
+}
@@ -67,6 +67,7 @@
 #define VOL_SWING .1
 
 #define CONSTRAINT_ASPECT_RATIO_BANK	3
+#define MAX_HTREE_LEVEL		32			/* The number of mats per row or column is an int, so log2 of it is below 32 */
 
 #define BITLINE_LEAKAGE_TOLERANCE	1
 #define IR_DROP_TOLERANCE 			0.2
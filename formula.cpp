@@ -14,24 +14,24 @@ bool isPow2(int n) {
 	return !(n & (n - 1));
 }
 
-double CalculateGateCap(double width, Technology tech) {
+double CalculateGateCap(double width, const Technology &tech) {
 	return (tech.capIdealGate + tech.capOverlap + 3 * tech.capFringe) * width
 			+ tech.phyGateLength * tech.capPolywire;
 }
 
-double CalculateFBRAMGateCap(double width, double thicknessFactor, Technology tech) {
+double CalculateFBRAMGateCap(double width, double thicknessFactor, const Technology &tech) {
 	return (tech.capIdealGate / thicknessFactor + tech.capOverlap + 3 * tech.capFringe) * width
 			+ tech.phyGateLength * tech.capPolywire;
 }
 
-double CalculateFBRAMDrainCap(double width, Technology tech) {
+double CalculateFBRAMDrainCap(double width, const Technology &tech) {
 	return (3 * tech.capSidewall + tech.capDrainToChannel) * width;
 }
 
 double CalculateGateArea(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const Technology &tech,
 		double *height, double *width) {
 	double	ratio = widthPMOS / (widthPMOS + widthNMOS);
 
@@ -116,7 +116,7 @@ double CalculateGateArea(
 void CalculateGateCapacitance(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const Technology &tech,
 		double *capInput, double *capOutput) {
 	/* TO-DO: most parts of this function is the same of CalculateGateArea,
 	 * perhaps they will be combined in future
@@ -234,7 +234,7 @@ void CalculateGateCapacitance(
 
 double CalculateDrainCap(
 		double width, int type,
-		double heightTransistorRegion, Technology tech) {
+		double heightTransistorRegion, const Technology &tech) {
 	double drainCap = 0;
 	if (type == NMOS)
 		CalculateGateCapacitance(INV, 1, width, 0, heightTransistorRegion, tech, NULL, &drainCap);
@@ -246,14 +246,14 @@ double CalculateDrainCap(
 double CalculateGateLeakage(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double temperature, Technology tech) {
+		double temperature, const Technology &tech) {
 	int tempIndex = (int)temperature - 300;
 	if ((tempIndex > 100) || (tempIndex < 0)) {
 		cout<<"Error: Temperature is out of range"<<endl;
 		exit(-1);
 	}
-	double *leakN = tech.currentOffNmos;
-	double *leakP = tech.currentOffPmos;
+	const double *leakN = tech.currentOffNmos;
+	const double *leakP = tech.currentOffPmos;
 	double leakageN, leakageP;
 	switch (gateType) {
 	case INV:
@@ -281,7 +281,7 @@ double CalculateGateLeakage(
 	}
 }
 
-double CalculateOnResistance(double width, int type, double temperature, Technology tech) {
+double CalculateOnResistance(double width, int type, double temperature, const Technology &tech) {
 	double r;
 	int tempIndex = (int)temperature - 300;
 	if ((tempIndex > 100) || (tempIndex < 0)) {
@@ -295,7 +295,7 @@ double CalculateOnResistance(double width, int type, double temperature, Technol
 	return r;
 }
 
-double CalculateTransconductance(double width, int type, Technology tech) {
+double CalculateTransconductance(double width, int type, const Technology &tech) {
 	double gm;
 	double vsat;
 	if (type == NMOS) {
@@ -18,38 +18,38 @@
 bool isPow2(int n);
 
 /* calculate the gate capacitance */
-double CalculateGateCap(double width, Technology tech);
+double CalculateGateCap(double width, const Technology &tech);
 
 double CalculateGateArea(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const Technology &tech,
 		double *height, double *width);
 
 /* calculate the capacitance of a gate */
 void CalculateGateCapacitance(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const Technology &tech,
 		double *capInput, double *capOutput);
 
 double CalculateDrainCap(
 		double width, int type,
-		double heightTransistorRegion, Technology tech);
+		double heightTransistorRegion, const Technology &tech);
 
 /* calculate the capacitance of a FBRAM */
-double CalculateFBRAMGateCap(double width, double thicknessFactor, Technology tech);
+double CalculateFBRAMGateCap(double width, double thicknessFactor, const Technology &tech);
 
-double CalculateFBRAMDrainCap(double width, Technology tech);
+double CalculateFBRAMDrainCap(double width, const Technology &tech);
 
 double CalculateGateLeakage(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double temperature, Technology tech);
+		double temperature, const Technology &tech);
 
-double CalculateOnResistance(double width, int type, double temperature, Technology tech);
+double CalculateOnResistance(double width, int type, double temperature, const Technology &tech);
 
-double CalculateTransconductance(double width, int type, Technology tech);
+double CalculateTransconductance(double width, int type, const Technology &tech);
 
 double horowitz(double tr, double beta, double rampInput, double *rampOutput);
 
@@ -13,13 +13,14 @@
 #include "MemCell.h"
 #include "Wire.h"
 
-extern InputParameter *inputParameter;
-extern Technology *tech;
-extern Technology *devtech;
-extern MemCell *cell;
+/* The evaluation state is thread-local so that each exploration thread works on its own copies */
+extern thread_local InputParameter *inputParameter;
+extern thread_local Technology *tech;
+extern thread_local Technology *devtech;
+extern thread_local MemCell *cell;
 extern Technology *gtech;
-extern Wire *localWire;		/* The wire type of local interconnects (for example, wire in mat) */
-extern Wire *globalWire;	/* The wire type of global interconnects (for example, the ones that connect mats) */
+extern thread_local Wire *localWire;	/* The wire type of local interconnects (for example, wire in mat) */
+extern thread_local Wire *globalWire;	/* The wire type of global interconnects (for example, the ones that connect mats) */
 extern MemCell **sweepCells;
 
 const double invalid_value = 1e41;
@@ -25,7 +25,8 @@
 		isBasicLowSwing = inputParameter->minIsLocalWireLowSwing; \
 	else \
 		isBasicLowSwing = false; \
-	localWire->Initialize(inputParameter->processNode, basicWireType, basicWireRepeaterType, inputParameter->temperature, isBasicLowSwing); \
+	WireLibrary::SharedLibrary().Load(localWire, inputParameter->processNode, basicWireType, basicWireRepeaterType, \
+			inputParameter->temperature, isBasicLowSwing); \
 	if (inputParameter->minGlobalWireType == inputParameter->maxGlobalWireType) \
 		basicWireType = (WireType)inputParameter->minGlobalWireType; \
 	else \
@@ -38,7 +39,8 @@
 		isBasicLowSwing = inputParameter->minIsGlobalWireLowSwing; \
 	else \
 		isBasicLowSwing = false; \
-	globalWire->Initialize(inputParameter->processNode, basicWireType, basicWireRepeaterType, inputParameter->temperature, isBasicLowSwing); \
+	WireLibrary::SharedLibrary().Load(globalWire, inputParameter->processNode, basicWireType, basicWireRepeaterType, \
+			inputParameter->temperature, isBasicLowSwing); \
 }
 
 
@@ -57,47 +59,113 @@
 	if ((WireRepeaterType)globalWireRepeaterType == repeated_none || (bool)isGlobalWireLowSwing == false)
 
 
+/* The wire of the current iteration of REFINE_LOCAL_WIRE_FORLOOP */
+#define LOAD_REFINED_LOCAL_WIRE \
+	WireLibrary::SharedLibrary().Load(localWire, inputParameter->processNode, (WireType)localWireType, \
+			(WireRepeaterType)localWireRepeaterType, inputParameter->temperature, (bool)isLocalWireLowSwing);
+
+
+/* The wire of the current iteration of REFINE_GLOBAL_WIRE_FORLOOP */
+#define LOAD_REFINED_GLOBAL_WIRE \
+	WireLibrary::SharedLibrary().Load(globalWire, inputParameter->processNode, (WireType)globalWireType, \
+			(WireRepeaterType)globalWireRepeaterType, inputParameter->temperature, (bool)isGlobalWireLowSwing);
+
+
 
 
 #define LOAD_GLOBAL_WIRE(oldResult) { \
-	globalWire->Initialize(inputParameter->processNode, (oldResult).globalWire->wireType, (oldResult).globalWire->wireRepeaterType, \
-			inputParameter->temperature, (oldResult).globalWire->isLowSwing); \
+	WireLibrary::SharedLibrary().Load(globalWire, inputParameter->processNode, (oldResult).globalWire->wireType, \
+			(oldResult).globalWire->wireRepeaterType, inputParameter->temperature, (oldResult).globalWire->isLowSwing); \
 }
 
 
 #define LOAD_LOCAL_WIRE(oldResult) \
-	localWire->Initialize(inputParameter->processNode, (oldResult).localWire->wireType, (oldResult).localWire->wireRepeaterType, \
-			inputParameter->temperature, (oldResult).localWire->isLowSwing);
+	WireLibrary::SharedLibrary().Load(localWire, inputParameter->processNode, (oldResult).localWire->wireType, \
+			(oldResult).localWire->wireRepeaterType, inputParameter->temperature, (oldResult).localWire->isLowSwing);
 
 
 
-#define TRY_AND_UPDATE(oldResult, memoryType) { \
-	if (inputParameter->routingMode == h_tree) \
-		trialBank = new BankWithHtree(); \
-	else \
-		trialBank = new BankWithoutHtree(); \
-	trialBank->Initialize((oldResult).bank->numRowMat, (oldResult).bank->numColumnMat, (oldResult).bank->capacity, (oldResult).bank->blockSize, (oldResult).bank->associativity, \
+#define CALCULATE_FROM_RESULT(trialBank, oldResult, memoryType) { \
+	(trialBank) = BankPool::ThreadPool().Acquire(); \
+	(trialBank)->Initialize((oldResult).bank->numRowMat, (oldResult).bank->numColumnMat, (oldResult).bank->capacity, (oldResult).bank->blockSize, (oldResult).bank->associativity, \
 				(oldResult).bank->numRowPerSet, (oldResult).bank->numActiveMatPerRow, (oldResult).bank->numActiveMatPerColumn, (oldResult).bank->muxSenseAmp, \
 				inputParameter->internalSensing, (oldResult).bank->muxOutputLev1, (oldResult).bank->muxOutputLev2, (oldResult).bank->numRowSubarray, (oldResult).bank->numColumnSubarray, \
-				(oldResult).bank->numActiveSubarrayPerRow, (oldResult).bank->numActiveSubarrayPerColumn, (oldResult).bank->areaOptimizationLevel, (memoryType), (oldResult).bank->stackedDieCount, (oldResult).bank->partitionGranularity, inputParameter->monolithicStackCount); \
-	trialBank->CalculateArea(); \
-	trialBank->CalculateRC(); \
-	trialBank->CalculateLatencyAndPower(); \
-	*(tempResult.bank) = *trialBank; \
+				(oldResult).bank->numActiveSubarrayPerRow, (oldResult).bank->numActiveSubarrayPerColumn, (oldResult).bank->areaOptimizationLevel, (memoryType), (oldResult).bank->stackedDieCount, (oldResult).bank->partitionGranularity, inputParameter->monolithicStackCount, evalContext); \
+	(trialBank)->CalculateArea(); \
+	(trialBank)->CalculateRC(); \
+	(trialBank)->CalculateLatencyAndPower(); \
+}
+
+
+/* Same as CALCULATE_FROM_RESULT for a design on the Pareto frontier, the array size is that of the current pass */
+#define CALCULATE_FROM_POINT(trialBank, point, memoryType) { \
+	(trialBank) = BankPool::ThreadPool().Acquire(); \
+	(trialBank)->Initialize((point).numRowMat, (point).numColumnMat, capacity, blockSize, associativity, \
+				(point).numRowPerSet, (point).numActiveMatPerRow, (point).numActiveMatPerColumn, (point).muxSenseAmp, \
+				inputParameter->internalSensing, (point).muxOutputLev1, (point).muxOutputLev2, (point).numRowSubarray, (point).numColumnSubarray, \
+				(point).numActiveSubarrayPerRow, (point).numActiveSubarrayPerColumn, (BufferDesignTarget)(point).areaOptimizationLevel, (memoryType), \
+				(point).stackedDieCount, (point).partitionGranularity, inputParameter->monolithicStackCount, evalContext); \
+	(trialBank)->CalculateArea(); \
+	(trialBank)->CalculateRC(); \
+	(trialBank)->CalculateLatencyAndPower(); \
+}
+
+
+#define LOAD_LOCAL_WIRE_FROM_POINT(point) \
+	WireLibrary::SharedLibrary().Load(localWire, inputParameter->processNode, (WireType)(point).localWireType, \
+			(WireRepeaterType)(point).localWireRepeaterType, inputParameter->temperature, (bool)(point).isLocalWireLowSwing);
+
+
+#define LOAD_GLOBAL_WIRE_FROM_POINT(point) \
+	WireLibrary::SharedLibrary().Load(globalWire, inputParameter->processNode, (WireType)(point).globalWireType, \
+			(WireRepeaterType)(point).globalWireRepeaterType, inputParameter->temperature, (bool)(point).isGlobalWireLowSwing);
+
+
+#define UPDATE_FROM_BANK(trialBank, oldResult) { \
+	*(tempResult.bank) = *(trialBank); \
 	*(tempResult.localWire) = *localWire; \
 	*(tempResult.globalWire) = *globalWire; \
 	oldResult.compareAndUpdate(tempResult); \
-	delete trialBank; \
 }
 
 
+#define TRY_AND_UPDATE(oldResult, memoryType) { \
+	CALCULATE_FROM_RESULT(trialBank, oldResult, memoryType); \
+	UPDATE_FROM_BANK(trialBank, oldResult); \
+	BankPool::ThreadPool().Release(trialBank); \
+}
 
-#define BIGFOR \
+
+/* Same as TRY_AND_UPDATE when only the global wire changes: routedBank is kept across the calls
+ * (NULL the first time), and a bank that is valid keeps its mat and only recalculates its routing.
+ * A bank that is invalid is calculated again from the start, so that it is printed the same way */
+#define REROUTE_AND_UPDATE(routedBank, oldResult, memoryType) { \
+	if ((routedBank) && (routedBank)->routable && !(routedBank)->invalid) \
+		(routedBank)->Reroute(); \
+	if (!(routedBank) || !(routedBank)->routable || (routedBank)->invalid) { \
+		if (routedBank) \
+			BankPool::ThreadPool().Release(routedBank); \
+		CALCULATE_FROM_RESULT(routedBank, oldResult, memoryType); \
+	} \
+	UPDATE_FROM_BANK(routedBank, oldResult); \
+}
+
+
+
+/* BIGFOR is split into the bank-level loops (BIGFOR_BANK) and the mat-level loops (BIGFOR_MAT) so that
+ * the parallel exploration can hand out one bank organization at a time as a chunk of work */
+#define BIGFOR BIGFOR_BANK BIGFOR_MAT
+
+
+#define BIGFOR_BANK \
 	for (numRowMat = inputParameter->minNumRowMat; numRowMat <= inputParameter->maxNumRowMat; numRowMat *= 2) \
 	for (numColumnMat = inputParameter->minNumColumnMat; numColumnMat <= inputParameter->maxNumColumnMat; numColumnMat *= 2) \
     for (stackedDieCount = inputParameter->minStackLayer; stackedDieCount <= inputParameter->maxStackLayer; stackedDieCount *= 2) \
 	for (numActiveMatPerRow = MIN(numColumnMat, inputParameter->minNumActiveMatPerRow); numActiveMatPerRow <= MIN(numColumnMat, inputParameter->maxNumActiveMatPerRow); numActiveMatPerRow *= 2) \
-	for (numActiveMatPerColumn = MIN(numRowMat, inputParameter->minNumActiveMatPerColumn); numActiveMatPerColumn <= MIN(numRowMat, inputParameter->maxNumActiveMatPerColumn); numActiveMatPerColumn *= 2) \
+	for (numActiveMatPerColumn = MIN(numRowMat, inputParameter->minNumActiveMatPerColumn); numActiveMatPerColumn <= MIN(numRowMat, inputParameter->maxNumActiveMatPerColumn); numActiveMatPerColumn *= 2)
+
+
+#define BIGFOR_MAT \
 	for (numRowSubarray = inputParameter->minNumRowSubarray; numRowSubarray <= inputParameter->maxNumRowSubarray; numRowSubarray *= 2) \
 	for (numColumnSubarray = inputParameter->minNumColumnSubarray; numColumnSubarray <= inputParameter->maxNumColumnSubarray; numColumnSubarray *= 2) \
 	for (numActiveSubarrayPerRow = MIN(numColumnSubarray, inputParameter->minNumActiveSubarrayPerRow); numActiveSubarrayPerRow <= MIN(numColumnSubarray, inputParameter->maxNumActiveSubarrayPerRow); numActiveSubarrayPerRow *=2) \
@@ -111,21 +179,26 @@
 
 
 #define CALCULATE(bank, memoryType) { \
-	if (inputParameter->routingMode == h_tree) \
-		(bank) = new BankWithHtree(); \
-	else \
-		(bank) = new BankWithoutHtree(); \
+	(bank) = BankPool::ThreadPool().Acquire(); \
 	(bank)->Initialize(numRowMat, numColumnMat, capacity, blockSize, associativity, \
 				numRowPerSet, numActiveMatPerRow, numActiveMatPerColumn, muxSenseAmp, \
 				inputParameter->internalSensing, muxOutputLev1, muxOutputLev2, numRowSubarray, numColumnSubarray, \
 				numActiveSubarrayPerRow, numActiveSubarrayPerColumn, (BufferDesignTarget)areaOptimizationLevel, \
-                (memoryType), stackedDieCount, partitionGranularity, inputParameter->monolithicStackCount); \
+                (memoryType), stackedDieCount, partitionGranularity, inputParameter->monolithicStackCount, evalContext); \
 	(bank)->CalculateArea(); \
 	(bank)->CalculateRC(); \
 	(bank)->CalculateLatencyAndPower(); \
 }
 
 
+/* Whether designFilter knows that the design of the BIGFOR indices is invalid, in which case it is not calculated */
+#define REJECT(designFilter, memoryType) \
+	(designFilter).Reject(numRowMat, numColumnMat, capacity, blockSize, associativity, numRowPerSet, \
+			numActiveMatPerRow, numActiveMatPerColumn, muxSenseAmp, muxOutputLev1, muxOutputLev2, \
+			numRowSubarray, numColumnSubarray, numActiveSubarrayPerRow, numActiveSubarrayPerColumn, \
+			(memoryType), stackedDieCount)
+
+
 #define UPDATE_BEST_DATA { \
 	*(tempResult.bank) = *dataBank; \
 	*(tempResult.localWire) = *localWire; \
@@ -326,13 +399,27 @@
 }
 
 
+#define OUTPUT_RESULT(result, tagResult) { \
+	PROFILE(profile_output); \
+	if (inputParameter->outputFormat == binary_format) { \
+		if (inputParameter->designTarget == cache) \
+			(result).printAsCacheToBinaryFile(tagResult, inputParameter->cacheAccessMode, outputFile); \
+		else \
+			(result).printToBinaryFile(outputFile); \
+	} else if (inputParameter->designTarget == cache) { \
+		(result).printAsCacheToCsvFile(tagResult, inputParameter->cacheAccessMode, outputFile); \
+	} else { \
+		(result).printToCsvFile(outputFile); \
+		outputFile << "\n"; \
+	} \
+}
+
 #define OUTPUT_TO_FILE { \
 	if (inputParameter->designTarget == cache) { \
 		for (int i = 0; i < (int)full_exploration; i++) \
-			tempResult.printAsCacheToCsvFile(bestTagResults[i], inputParameter->cacheAccessMode, outputFile); \
+			OUTPUT_RESULT(tempResult, bestTagResults[i]); \
 	} else { \
-		tempResult.printToCsvFile(outputFile); \
-		outputFile << endl; \
+		OUTPUT_RESULT(tempResult, bestTagResults[0]); \
 	} \
 }
 
@@ -11,6 +11,9 @@
 #include <iomanip>
 #include <math.h>
 #include <cassert>
+#include <thread>
+#include <atomic>
+#include <vector>
 #include "InputParameter.h"
 #include "MemCell.h"
 #include "RowDecoder.h"
@@ -18,6 +21,7 @@
 #include "OutputDriver.h"
 #include "SenseAmp.h"
 #include "Technology.h"
+#include "TechnologyLibrary.h"
 #include "BasicDecoder.h"
 #include "PredecodeBlock.h"
 #include "SubArray.h"
@@ -25,23 +29,41 @@
 #include "BankWithHtree.h"
 #include "BankWithoutHtree.h"
 #include "Wire.h"
+#include "WireLibrary.h"
 #include "Result.h"
 #include "formula.h"
 #include "macros.h"
 #include "TSV.h"
+#include "ParallelExplorer.h"
+#include "EvalContext.h"
+#include "SubArrayCache.h"
+#include "MatCache.h"
+#include "BankPool.h"
+#include "ParetoArchive.h"
+#include "SearchBound.h"
+#include "DesignStore.h"
+#include "DesignFilter.h"
+#include "CsvWriter.h"
+#include "ColumnFile.h"
+#include "Profiler.h"
 
 using namespace std;
 
-InputParameter *inputParameter;
-Technology *tech;
-Technology *devtech;
-MemCell *cell;
-Wire *localWire;
-Wire *globalWire;
+thread_local InputParameter *inputParameter;
+thread_local Technology *tech;
+thread_local Technology *devtech;
+thread_local MemCell *cell;
+thread_local Wire *localWire;
+thread_local Wire *globalWire;
 MemCell **sweepCells;
 
+int numThreadsOverride = 0;	/* Number of threads given by --threads, 0 if -Threads in the configuration file is used */
+
 void applyConstraint();
-int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Result *bestDataResults, Result *bestTagResults);
+void exploreCells(int numCellTypes, CsvWriter& outputFile, Result **bestDataResults, Result **bestTagResults,
+		int& failures, long long& totalSolutions, long long& totalParetoDesigns);
+long long exploreTag(Result *bestTagResults);
+int nvsim(CsvWriter& outputFile, ostream& log, long long& numSolution, Result *bestDataResults, Result *bestTagResults, ParetoArchive *paretoArchive);
 
 void tsvVerif(InputParameter *inputParameter)
 {
@@ -50,6 +72,8 @@ void tsvVerif(InputParameter *inputParameter)
     bool interpolate = true;
     bool buffered = false;
 
+    tech = new Technology();
+
     // 4 types of TSVs at each node
     // -- Aggressive interconnect, ITRS projection
     // -- Conservative interconnect, ITRS projection
@@ -67,39 +91,23 @@ void tsvVerif(InputParameter *inputParameter)
                 inputParameter->localTsvProjection = 0;
                 inputParameter->globalTsvProjection = 1;
 
-                tech = new Technology();
-                tech->Initialize(techNodes[node], HP, inputParameter);
-                tech->SetLayerCount(inputParameter, layers);
-
                 if (interpolate) {
-                    Technology techHigh;
-                    double alpha = 0;
-                    if (techNodes[node] > 65) { // 65 nm < technology node <= 90 nm
-                        techHigh.Initialize(90, inputParameter->deviceRoadmap, inputParameter);
-                        alpha = (techNodes[node] - 65.0) / 25;
-                    } else if (techNodes[node] > 45) { // 45 nm < technology node <= 65 nm
-                        techHigh.Initialize(65, inputParameter->deviceRoadmap, inputParameter);
-                        alpha = (techNodes[node] - 45.0) / 20;
-                    } else if (techNodes[node] >= 32) { // 32 nm < technology node <= 45 nm
-                        techHigh.Initialize(45, inputParameter->deviceRoadmap, inputParameter);
-                        alpha = (techNodes[node] - 32.0) / 13;
-                    } else if (techNodes[node] >= 22) { // 22 nm < technology node <= 32 nm
-                        techHigh.Initialize(32, inputParameter->deviceRoadmap, inputParameter);
-                        alpha = (techNodes[node] - 22.0) / 10;
-                    }
-
-                    tech->InterpolateWith(techHigh, alpha);
+                    TechnologyLibrary::SharedLibrary().Load(tech, techNodes[node], HP, inputParameter);
+                } else {
+                    *tech = Technology();
+                    tech->Initialize(techNodes[node], HP, inputParameter);
                 }
+                tech->SetLayerRange(inputParameter, layers, layers);
 
                 TSV tsv1;
 
-                tsv1.Initialize(Fine, buffered);
+                tsv1.Initialize(Fine, layers, buffered);
                 tsv1.CalculateArea();
                 tsv1.CalculateLatencyAndPower(infinite_ramp, infinite_ramp);
 
                 TSV tsv2;
 
-                tsv2.Initialize(Coarse, buffered);
+                tsv2.Initialize(Coarse, layers, buffered);
                 tsv2.CalculateArea();
                 tsv2.CalculateLatencyAndPower(infinite_ramp, infinite_ramp);
 
@@ -123,11 +131,24 @@ int main(int argc, char *argv[])
 	cout << fixed << setprecision(3);
 	string inputFileName;
 
-	if (argc == 1) {
+	for (int argIdx = 1; argIdx < argc; argIdx++) {
+		string arg = argv[argIdx];
+		if (arg == "--threads" && argIdx + 1 < argc) {
+			numThreadsOverride = atoi(argv[++argIdx]);
+		} else if (!arg.compare(0, strlen("--threads="), "--threads=")) {
+			numThreadsOverride = atoi(arg.c_str() + strlen("--threads="));
+		} else if (arg == "--threads") {
+			cout << "[ERROR] --threads requires the number of threads" << endl;
+			exit(-1);
+		} else {
+			inputFileName = arg;
+		}
+	}
+
+	if (inputFileName.empty()) {
 		inputFileName = "nvsim.cfg";
 		cout << "Default configuration file (nvsim.cfg) is loaded" << endl;
 	} else {
-		inputFileName = argv[1];
 		cout << "User-defined configuration file (" << inputFileName << ") is loaded" << endl;
 	}
 	cout << endl;
@@ -135,44 +156,28 @@ int main(int argc, char *argv[])
 	inputParameter = new InputParameter();
 	RESTORE_SEARCH_SIZE;
 	inputParameter->ReadInputParameterFromFile(inputFileName);
+	if (numThreadsOverride > 0)
+		inputParameter->numThreads = numThreadsOverride;
+	Profiler::enabled = (inputParameter->profileFormat != no_profile);
 
     //tsvVerif(inputParameter);
 
+	/* Interpolated between the nodes of the technology tables */
 	tech = new Technology();
-	tech->Initialize(inputParameter->processNode, inputParameter->deviceRoadmap, inputParameter);
-
-	Technology techHigh;
-	double alpha = 0;
-	if (inputParameter->processNode > 200){
-		// TO-DO: technology node > 200 nm
-	} else if (inputParameter->processNode > 120) { // 120 nm < technology node <= 200 nm
-		techHigh.Initialize(200, inputParameter->deviceRoadmap, inputParameter);
-		alpha = (inputParameter->processNode - 120.0) / 60;
-	} else if (inputParameter->processNode > 90) { // 90 nm < technology node <= 120 nm
-		techHigh.Initialize(120, inputParameter->deviceRoadmap, inputParameter);
-		alpha = (inputParameter->processNode - 90.0) / 30;
-	} else if (inputParameter->processNode > 65) { // 65 nm < technology node <= 90 nm
-		techHigh.Initialize(90, inputParameter->deviceRoadmap, inputParameter);
-		alpha = (inputParameter->processNode - 65.0) / 25;
-	} else if (inputParameter->processNode > 45) { // 45 nm < technology node <= 65 nm
-		techHigh.Initialize(65, inputParameter->deviceRoadmap, inputParameter);
-		alpha = (inputParameter->processNode - 45.0) / 20;
-	} else if (inputParameter->processNode >= 32) { // 32 nm < technology node <= 45 nm
-		techHigh.Initialize(45, inputParameter->deviceRoadmap, inputParameter);
-		alpha = (inputParameter->processNode - 32.0) / 13;
-	} else if (inputParameter->processNode >= 22) { // 22 nm < technology node <= 32 nm
-		techHigh.Initialize(32, inputParameter->deviceRoadmap, inputParameter);
-		alpha = (inputParameter->processNode - 22.0) / 10;
-	} else {
-		//TO-DO: technology node < 22 nm
-	}
+	TechnologyLibrary::SharedLibrary().Load(tech, inputParameter->processNode, inputParameter->deviceRoadmap, inputParameter);
+	/* The TSVs of every stacked die count that the exploration can reach, whatever the order of the passes */
+	tech->SetLayerRange(inputParameter, inputParameter->minStackLayer, inputParameter->maxStackLayer);
 
-	tech->InterpolateWith(techHigh, alpha);
+	/* Every wire that the exploration can switch to, with the final technology */
+	WireLibrary::SharedLibrary().Initialize(inputParameter->processNode, inputParameter->temperature);
 
-    /* Open output file for full_exploration. */
+    /* Open output file for full_exploration or pareto_exploration. */
     ofstream outputFile;
+	ColumnFileWriter columnFile;	/* Turns the row records into columns for -OutputFormat: binary */
+	ostream columnStream(&columnFile);
+	CsvWriter csvWriter;	/* The designs are written to outputFile through this one */
 	string outputFileName;
-	if (inputParameter->optimizationTarget == full_exploration) {
+	if (inputParameter->optimizationTarget == full_exploration || inputParameter->optimizationTarget == pareto_exploration) {
 		/*stringstream temp;
 		temp << inputParameter->outputFilePrefix << "_" << inputParameter->capacity / 1024 << "K_" << inputParameter->wordWidth
 				<< "_" << inputParameter->associativity;
@@ -187,12 +192,23 @@ int main(int argc, char *argv[])
 		temp << ".csv";
 		outputFileName = temp.str();*/
         int extIdx = inputFileName.find_last_of("."); 
-        outputFileName = inputFileName.substr(0, extIdx) + ".csv";
-		outputFile.open(outputFileName.c_str(), ofstream::out | ofstream::trunc);
+        if (inputParameter->outputFormat == binary_format) {
+			outputFileName = inputFileName.substr(0, extIdx) + ".bin";
+			outputFile.open(outputFileName.c_str(), ofstream::out | ofstream::trunc | ofstream::binary);
+		} else {
+			outputFileName = inputFileName.substr(0, extIdx) + ".csv";
+			outputFile.open(outputFileName.c_str(), ofstream::out | ofstream::trunc);
+		}
         if (!outputFile.is_open()) {
             cout << "Could not open file " << outputFileName << "!" << endl;
             exit(-1);
         }
+		if (inputParameter->outputFormat == binary_format) {
+			columnFile.Open(&outputFile, inputParameter->designTarget == cache);
+			csvWriter.Open(&columnStream, inputParameter->backgroundWriter);
+		} else {
+			csvWriter.Open(&outputFile, inputParameter->backgroundWriter);
+		}
 	}
 
     int numCellTypes = inputParameter->fileMemCell.size();
@@ -203,7 +219,10 @@ int main(int argc, char *argv[])
 
     int failures = 0;
     long long totalSolutions = 0;
-    for (int cellIdx = 0; cellIdx < numCellTypes; cellIdx++) {
+    long long totalParetoDesigns = 0;
+    if (inputParameter->numCellThreads > 1 && numCellTypes > 1) {
+        exploreCells(numCellTypes, csvWriter, bestDataResults, bestTagResults, failures, totalSolutions, totalParetoDesigns);
+    } else for (int cellIdx = 0; cellIdx < numCellTypes; cellIdx++) {
         long long solutions = 0;
         sweepCells[cellIdx] = new MemCell();
         sweepCells[cellIdx]->ReadCellFromFile(inputParameter->fileMemCell[cellIdx]);
@@ -227,24 +246,37 @@ int main(int argc, char *argv[])
         bestDataResults[cellIdx] = new Result[(int)full_exploration];
         bestTagResults[cellIdx] = new Result[(int)full_exploration];
 
-        /* Find the best solutions, pruned solutions, or all solutions for this cell type. */
-        if (nvsim(outputFile, inputFileName, solutions, bestDataResults[cellIdx], bestTagResults[cellIdx])) {
+        /* Find the best solutions, pruned solutions, all solutions, or the Pareto frontier for this cell type. */
+        ParetoArchive *paretoArchive = NULL;
+        if (inputParameter->optimizationTarget == pareto_exploration)
+            paretoArchive = new ParetoArchive();
+        if (nvsim(csvWriter, cout, solutions, bestDataResults[cellIdx], bestTagResults[cellIdx], paretoArchive)) {
             failures++;
         } else {
             totalSolutions += solutions;
+            if (paretoArchive)
+                totalParetoDesigns += paretoArchive->Size();
         }
+        if (paretoArchive)
+            delete paretoArchive;
 
         if (cell->memCellType == eDRAM && false) {
             delete devtech;
         }
     }
 
+    if (inputParameter->printLevel > 1)
+    {
+        MatCache::PrintStatistics();
+        SubArrayCache::PrintStatistics();
+    }
+
     /* Compare against results from previous cell types. */
     if (inputParameter->optimizationTarget == full_exploration 
         && inputParameter->isPruningEnabled
         && inputParameter->doublePrune) {
         /* Pick the best of the best over all the cell types for each x,y,z pruning triple. */
-    } else if (inputParameter->optimizationTarget != full_exploration) {
+    } else if (inputParameter->optimizationTarget != full_exploration && inputParameter->optimizationTarget != pareto_exploration) {
         /* Pick the best of the best for each optimization target. */
         for (int cellIdx = 1; cellIdx < numCellTypes; cellIdx++) {
             for (int tgtIdx = 0; tgtIdx < (int)full_exploration; tgtIdx++) {
@@ -271,7 +303,13 @@ int main(int argc, char *argv[])
         }
     }
 
-	if (inputParameter->optimizationTarget != full_exploration) {
+	if (inputParameter->optimizationTarget == pareto_exploration) {
+		cout << endl << outputFileName << " generated successfully!" << endl;
+		int solutionMultiplier = 1;
+		if (inputParameter->designTarget == cache)
+			solutionMultiplier = 8;
+		cout << totalParetoDesigns * solutionMultiplier << " solutions on the Pareto frontier (out of " << totalSolutions * solutionMultiplier << ")" << endl;
+	} else if (inputParameter->optimizationTarget != full_exploration) {
 		if (totalSolutions > 0 && !inputParameter->printAllOptimals) {
             cell = bestDataResults[0][inputParameter->optimizationTarget].cellTech;
             //cell->PrintCell();
@@ -307,15 +345,214 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	csvWriter.Close();
+	columnFile.Close();
 	if (outputFile.is_open())
 		outputFile.close();
 
+	if (inputParameter->profileFormat == table_profile) {
+		Profiler::PrintStatistics(cout);
+	} else if (inputParameter->profileFormat == json_profile) {
+		string profileFileName = inputFileName.substr(0, inputFileName.find_last_of(".")) + ".profile.json";
+		ofstream profileFile(profileFileName.c_str(), ofstream::out | ofstream::trunc);
+		Profiler::PrintJson(profileFile);
+		cout << profileFileName << " generated successfully!" << endl;
+	}
+
 	return 0;
 }
 
-int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Result *bestDataResults, Result *bestTagResults)
+/* Explore every cell type with nvsim() on numCellThreads threads, each cell type with its own copy of the
+ * input parameters and the technology. The designs and the messages of each cell type are buffered and
+ * written in the order of the cell types, so the output is the same as the one of the serial loop in main() */
+void exploreCells(int numCellTypes, CsvWriter& outputFile, Result **bestDataResults, Result **bestTagResults,
+		int& failures, long long& totalSolutions, long long& totalParetoDesigns)
+{
+	struct CellExploration {
+		InputParameter parameter;
+		Technology tech;
+		CsvWriter output;		/* Designs written to the output file, kept in memory */
+		ostringstream log;		/* Messages of nvsim() */
+		ParetoArchive *paretoArchive;
+		long long solutions;
+		bool failed;
+	};
+	vector<CellExploration> explorations(numCellTypes);
+
+	for (int cellIdx = 0; cellIdx < numCellTypes; cellIdx++) {
+		sweepCells[cellIdx] = new MemCell();
+		sweepCells[cellIdx]->ReadCellFromFile(inputParameter->fileMemCell[cellIdx]);
+		sweepCells[cellIdx]->ApplyPVT();
+
+		/* Every cell type starts from the state that the serial loop would start it from */
+		CellExploration &exploration = explorations[cellIdx];
+		exploration.parameter = *inputParameter;
+		exploration.tech = *tech;
+		exploration.log << fixed << setprecision(3);	/* Same format as cout */
+		exploration.paretoArchive = NULL;
+		if (inputParameter->optimizationTarget == pareto_exploration)
+			exploration.paretoArchive = new ParetoArchive();
+		exploration.solutions = 0;
+		exploration.failed = false;
+
+		/* The results read the input parameters when they are constructed */
+		bestDataResults[cellIdx] = new Result[(int)full_exploration];
+		bestTagResults[cellIdx] = new Result[(int)full_exploration];
+	}
+
+	cell = sweepCells[0];
+	devtech = tech;
+	inputParameter->PrintInputParameter();
+
+	atomic<int> nextCell(0);
+	auto work = [&]() {
+		int cellIdx;
+		while ((cellIdx = nextCell++) < numCellTypes) {
+			CellExploration &exploration = explorations[cellIdx];
+			inputParameter = &exploration.parameter;
+			tech = &exploration.tech;
+			devtech = tech;
+			cell = sweepCells[cellIdx];
+			exploration.failed = nvsim(exploration.output, exploration.log, exploration.solutions,
+					bestDataResults[cellIdx], bestTagResults[cellIdx], exploration.paretoArchive);
+		}
+		cell = NULL;
+		devtech = NULL;
+		tech = NULL;
+		inputParameter = NULL;
+	};
+
+	int numWorker = MIN(inputParameter->numCellThreads, numCellTypes);
+	vector<thread> workers;
+	for (int t = 0; t < numWorker; t++)
+		workers.push_back(thread(work));
+	for (int t = 0; t < numWorker; t++)
+		workers[t].join();
+
+	for (int cellIdx = 0; cellIdx < numCellTypes; cellIdx++) {
+		CellExploration &exploration = explorations[cellIdx];
+		cout << "Using cell file: " << inputParameter->fileMemCell[cellIdx] << endl;
+		cout << exploration.log.str();
+		outputFile.Write(exploration.output.Take());
+		if (exploration.failed) {
+			failures++;
+		} else {
+			totalSolutions += exploration.solutions;
+			if (exploration.paretoArchive)
+				totalParetoDesigns += exploration.paretoArchive->Size();
+		}
+		if (exploration.paretoArchive)
+			delete exploration.paretoArchive;
+	}
+
+	/* Leave the state of the main thread as the serial loop leaves it */
+	*inputParameter = explorations.back().parameter;
+	*tech = explorations.back().tech;
+	cell = sweepCells[numCellTypes - 1];
+}
+
+/* Search the cache tag array into bestTagResults with the state bound to the calling thread,
+ * returns the number of valid tag designs. tech is left with the layer count of the last design */
+long long exploreTag(Result *bestTagResults)
+{
+	PROFILE(profile_tag_search);
+	/* the search bounds of the data array are restored at the end of this scope */
+	SearchBoundsScope tagBounds(inputParameter);
+
+	int numRowMat, numColumnMat, numActiveMatPerRow, numActiveMatPerColumn;
+	int numRowSubarray, numColumnSubarray, numActiveSubarrayPerRow, numActiveSubarrayPerColumn;
+	int muxSenseAmp, muxOutputLev1, muxOutputLev2, numRowPerSet;
+	int areaOptimizationLevel;							/* actually BufferDesignTarget */
+	int localWireType, globalWireType;					/* actually WireType */
+	int localWireRepeaterType, globalWireRepeaterType;	/* actually WireRepeaterType */
+	int isLocalWireLowSwing, isGlobalWireLowSwing;		/* actually boolean value */
+	int stackedDieCount;
+	int partitionGranularity = inputParameter->partitionGranularity;
+	EvalContext *evalContext = NULL;	/* The designs are evaluated with the state bound to this thread */
+
+	long long capacity;
+	long blockSize;
+	int associativity;
+
+	long long numSolution = 0;
+	long long numDesigns = 0;
+	Bank *tagBank = NULL;
+
+	REDUCE_SEARCH_SIZE;
+	DesignFilter designFilter;
+	designFilter.Initialize();
+	/* calculate the tag configuration */
+	int numDataSet = inputParameter->capacity * 8 / inputParameter->wordWidth / inputParameter->associativity;
+	int numIndexBit = (int)(log2(numDataSet) + 0.1);
+	int numOffsetBit = (int)(log2(inputParameter->wordWidth / 8) + 0.1);
+	INITIAL_BASIC_WIRE;
+	/* Simulate tag */
+	Result tempResult;	/* Reused by all the designs */
+	if (inputParameter->numThreads > 1) {
+		ParallelExplorer explorer;
+		explorer.numThreads = inputParameter->numThreads;
+		explorer.partitionGranularity = partitionGranularity;
+		explorer.numIndexBit = numIndexBit;
+		explorer.numOffsetBit = numOffsetBit;
+		explorer.Explore(tag_pass, bestTagResults, numSolution, numDesigns);
+	} else BIGFOR {
+		blockSize = TOTAL_ADDRESS_BIT - numIndexBit - numOffsetBit;
+		blockSize += 2;		/* add dirty bits and valid bits */
+		if (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) == 0) {
+			/* To aggressive partitioning */
+			continue;
+		}
+		if (blockSize % (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn)) {
+			blockSize = (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) + 1)
+					* (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn);
+		}
+		capacity = (long long)inputParameter->capacity * 8 / inputParameter->wordWidth * blockSize;
+		associativity = inputParameter->associativity;
+		numDesigns++;
+		if (REJECT(designFilter, tag))
+			continue;
+		CALCULATE(tagBank, tag);
+		if (!tagBank->invalid) {
+			VERIFY_TAG_CAPACITY;
+			numSolution++;
+			UPDATE_BEST_TAG;
+		}
+		BankPool::ThreadPool().Release(tagBank);
+	}
+
+	if (numSolution > 0) {
+		Bank * trialBank;
+		/* refine local wire type */
+		REFINE_LOCAL_WIRE_FORLOOP {
+			LOAD_REFINED_LOCAL_WIRE;
+			for (int i = 0; i < (int)full_exploration; i++) {
+				LOAD_GLOBAL_WIRE(bestTagResults[i]);
+				TRY_AND_UPDATE(bestTagResults[i], tag);
+			}
+		}
+		/* refine global wire type, the organization and the local wire of each result stay the same */
+		Bank *routedBanks[(int)full_exploration] = {NULL};
+		REFINE_GLOBAL_WIRE_FORLOOP {
+			LOAD_REFINED_GLOBAL_WIRE;
+			for (int i = 0; i < (int)full_exploration; i++) {
+				LOAD_LOCAL_WIRE(bestTagResults[i]);
+				REROUTE_AND_UPDATE(routedBanks[i], bestTagResults[i], tag);
+			}
+		}
+		for (int i = 0; i < (int)full_exploration; i++)
+			if (routedBanks[i])
+				BankPool::ThreadPool().Release(routedBanks[i]);
+	}
+
+
+	return numSolution;
+}
+
+int nvsim(CsvWriter& outputFile, ostream& log, long long& numSolution, Result *bestDataResults, Result *bestTagResults, ParetoArchive *paretoArchive)
 {
 	applyConstraint();
+	/* Every cell type starts from the configured search bounds, whatever the passes below narrow down */
+	SearchBoundsScope configuredBounds(inputParameter);
 
 	int numRowMat, numColumnMat, numActiveMatPerRow, numActiveMatPerColumn;
 	int numRowSubarray, numColumnSubarray, numActiveSubarrayPerRow, numActiveSubarrayPerColumn;
@@ -325,6 +562,7 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 	int localWireRepeaterType, globalWireRepeaterType;	/* actually WireRepeaterType */
 	int isLocalWireLowSwing, isGlobalWireLowSwing;		/* actually boolean value */
     int stackedDieCount, partitionGranularity;
+	EvalContext *evalContext = NULL;	/* The designs are evaluated with the state bound to this thread */
 
 	long long capacity;
 	long blockSize;
@@ -342,7 +580,6 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 
 	/* for cache tag array only */
 	//Result *bestTagResults = new Result[(int)full_exploration];	/* full_exploration is always set as the last element in the enum, so if full_exploration is 8, what we want here is a 0-7 array, which is correct */
-	Bank *tagBank = NULL;
 	for (int i = 0; i < (int)full_exploration; i++) {
 		bestTagResults[i].optimizationTarget = (OptimizationTarget)i;
         bestTagResults[i].cellTech = cell;
@@ -354,78 +591,34 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
     partitionGranularity = inputParameter->partitionGranularity;
 
 	/* search tag first */
+	long long numTagSolution = 0;
+	thread tagThread;
+	InputParameter tagParameter;
+	EvalContext tagContext;
 	if (inputParameter->designTarget == cache) {
 		/* need to design the tag array */
-		REDUCE_SEARCH_SIZE;
-		/* calculate the tag configuration */
-		int numDataSet = inputParameter->capacity * 8 / inputParameter->wordWidth / inputParameter->associativity;
-		int numIndexBit = (int)(log2(numDataSet) + 0.1);
-		int numOffsetBit = (int)(log2(inputParameter->wordWidth / 8) + 0.1);
-		INITIAL_BASIC_WIRE;
-		/* Simulate tag */
-		BIGFOR {
-            tech->SetLayerCount(inputParameter, stackedDieCount);
-			blockSize = TOTAL_ADDRESS_BIT - numIndexBit - numOffsetBit;
-			blockSize += 2;		/* add dirty bits and valid bits */
-			if (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) == 0) {
-				/* To aggressive partitioning */
-				continue;
-			}
-			if (blockSize % (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn)) {
-				blockSize = (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) + 1)
-						* (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn);
-			}
-			capacity = (long long)inputParameter->capacity * 8 / inputParameter->wordWidth * blockSize;
-			associativity = inputParameter->associativity;
-			CALCULATE(tagBank, tag);
-            numDesigns++;
-			if (!tagBank->invalid) {
-				Result tempResult;
-				VERIFY_TAG_CAPACITY;
-				numSolution++;
-				UPDATE_BEST_TAG;
-			}
-			delete tagBank;
-		}
-
-		if (numSolution > 0) {
-			Bank * trialBank;
-			Result tempResult;
-			/* refine local wire type */
-			REFINE_LOCAL_WIRE_FORLOOP {
-				localWire->Initialize(inputParameter->processNode, (WireType)localWireType,
-						(WireRepeaterType)localWireRepeaterType, inputParameter->temperature,
-						(bool)isLocalWireLowSwing);
-				for (int i = 0; i < (int)full_exploration; i++) {
-					LOAD_GLOBAL_WIRE(bestTagResults[i]);
-					TRY_AND_UPDATE(bestTagResults[i], tag);
-				}
-			}
-			/* refine global wire type */
-			REFINE_GLOBAL_WIRE_FORLOOP {
-				globalWire->Initialize(inputParameter->processNode, (WireType)globalWireType,
-						(WireRepeaterType)globalWireRepeaterType, inputParameter->temperature,
-						(bool)isGlobalWireLowSwing);
-				for (int i = 0; i < (int)full_exploration; i++) {
-					LOAD_LOCAL_WIRE(bestTagResults[i]);
-					TRY_AND_UPDATE(bestTagResults[i], tag);
-				}
-			}
-		}
-
-		if (numSolution == 0) {
-			cout << "No valid solutions for tags." << endl;
-			cout << endl << "Finished!" << endl;
-			if (localWire) delete localWire;
-			if (globalWire) delete globalWire;
-			//outputFile.close();
-			return 1;
+		if (inputParameter->concurrentTagSearch && inputParameter->optimizationTarget != full_exploration
+				&& inputParameter->optimizationTarget != pareto_exploration) {
+			/* The data search only needs the tag results to print them, so the tag array is searched on its own thread
+			 * with private copies of the state */
+			tagParameter = *inputParameter;
+			INITIAL_BASIC_WIRE;
+			tagContext.Capture();
+			tagContext.inputParameter = &tagParameter;
+			tagThread = thread([&tagContext, &numTagSolution, bestTagResults]() {
+				tagContext.Bind();
+				numTagSolution = exploreTag(bestTagResults);
+			});
 		} else {
-			numSolution = 0;
-            numDesigns = 0;
-			RESTORE_SEARCH_SIZE;
-			inputParameter->ReadInputParameterFromFile(inputFileName);	/* just for restoring the search space */
-			applyConstraint();
+			numTagSolution = exploreTag(bestTagResults);
+			if (numTagSolution == 0) {
+				log << "No valid solutions for tags." << endl;
+				log << endl << "Finished!" << endl;
+				if (localWire) delete localWire;
+				if (globalWire) delete globalWire;
+				//outputFile.close();
+				return 1;
+			}
 		}
 	}
 
@@ -459,37 +652,135 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 	}
 
 	INITIAL_BASIC_WIRE;
-	BIGFOR {
-		if (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) == 0) {
-			/* To aggressive partitioning */
+	/* Branch and bound only keeps the best result of the optimization target, the other targets are not searched exhaustively */
+	SearchBound searchBound;
+	long long numPruned = 0;
+	if (inputParameter->branchAndBound && inputParameter->optimizationTarget < full_exploration
+			&& !inputParameter->printAllOptimals && !inputParameter->isConstraintApplied)
+		searchBound.Initialize(inputParameter->optimizationTarget, capacity, blockSize, associativity, partitionGranularity);
+	/* The pruned exploration and the constrained search answer their constrained optima from the metrics of every valid design */
+	DesignStore designStore;
+	bool storeDesigns = (inputParameter->optimizationTarget == full_exploration && inputParameter->isPruningEnabled)
+			|| (inputParameter->optimizationTarget != full_exploration && inputParameter->optimizationTarget != pareto_exploration
+			&& inputParameter->isConstraintApplied);
+	/* The designs that are known to be invalid from their indices are not calculated */
+	DesignFilter designFilter;
+	designFilter.Initialize();
+	Result tempResult;	/* Reused by all the designs */
+	ProfileScope dataSearch(profile_data_search);
+	if (inputParameter->numThreads > 1) {
+		ParallelExplorer explorer;
+		explorer.numThreads = inputParameter->numThreads;
+		explorer.capacity = capacity;
+		explorer.blockSize = blockSize;
+		explorer.associativity = associativity;
+		explorer.partitionGranularity = partitionGranularity;
+		explorer.bestTagResults = bestTagResults;
+		explorer.paretoArchive = paretoArchive;
+		explorer.searchBound = &searchBound;
+		if (storeDesigns)
+			explorer.designStore = &designStore;
+		if (inputParameter->optimizationTarget == full_exploration && !inputParameter->isPruningEnabled)
+			explorer.outputFile = &outputFile;
+		explorer.Explore(data_pass, bestDataResults, numSolution, numDesigns);
+		numPruned = explorer.numPruned;
+		designFilter.Merge(explorer.designFilter);
+	} else BIGFOR_BANK {
+		if (searchBound.Prune(bestDataResults[inputParameter->optimizationTarget], numRowMat, numColumnMat, stackedDieCount,
+				numActiveMatPerRow, numActiveMatPerColumn)) {
+			/* Only the designs that the exhaustive search counts in numDesigns */
+			BIGFOR_MAT
+				if (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) > 0)
+					numPruned++;
 			continue;
 		}
-        //if (capacity / (numRowMat * numColumnMat * numRowSubarray * numColumnSubarray) < 32*32) {
-        //    // Require at least 32x32 subarrays.
-        //    continue;
-        //}
-		CALCULATE(dataBank, MemoryType::data);
-        numDesigns++;
-		if (!dataBank->invalid) {
-			Result tempResult;
-			VERIFY_DATA_CAPACITY;
-			numSolution++;
-			UPDATE_BEST_DATA;
-			if (inputParameter->optimizationTarget == full_exploration && !inputParameter->isPruningEnabled) {
-				OUTPUT_TO_FILE;
+		BIGFOR_MAT {
+			if (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) == 0) {
+				/* To aggressive partitioning */
+				continue;
 			}
+			//if (capacity / (numRowMat * numColumnMat * numRowSubarray * numColumnSubarray) < 32*32) {
+			//    // Require at least 32x32 subarrays.
+			//    continue;
+			//}
+			numDesigns++;
+			if (REJECT(designFilter, MemoryType::data))
+				continue;
+			CALCULATE(dataBank, MemoryType::data);
+			searchBound.Record(*dataBank);
+			if (!dataBank->invalid) {
+				VERIFY_DATA_CAPACITY;
+				numSolution++;
+				if (storeDesigns)
+					designStore.Insert(*dataBank, *localWire, *globalWire, designStore.Size());
+				if (paretoArchive)
+					paretoArchive->Insert(*dataBank, *localWire, *globalWire);
+				else
+					UPDATE_BEST_DATA;
+				if (inputParameter->optimizationTarget == full_exploration && !inputParameter->isPruningEnabled) {
+					OUTPUT_TO_FILE;
+				}
+			}
+			BankPool::ThreadPool().Release(dataBank);
 		}
-		delete dataBank;
+		searchBound.FinishOrganization();
 	}
+	dataSearch.Stop();
 
-	if (numSolution > 0) {
+	ProfileScope wireRefinement(profile_wire_refinement);
+	if (paretoArchive && numSolution > 0) {
+		Bank * trialBank;
+		/* refine local wire type, every design on the frontier has the basic wires so far */
+		ParetoArchive explored = *paretoArchive;
+		REFINE_LOCAL_WIRE_FORLOOP {
+			LOAD_REFINED_LOCAL_WIRE;
+			for (int i = 0; i < explored.Size(); i++) {
+				const DesignPoint &point = explored.Point(i);
+				if (point.localWireType == localWireType && point.localWireRepeaterType == localWireRepeaterType
+						&& point.isLocalWireLowSwing == isLocalWireLowSwing)
+					continue;	/* Already on the frontier */
+				CALCULATE_FROM_POINT(trialBank, point, MemoryType::data);
+				if (!trialBank->invalid)
+					paretoArchive->Insert(*trialBank, *localWire, *globalWire);
+				BankPool::ThreadPool().Release(trialBank);
+			}
+		}
+		/* refine global wire type, the organization and the local wire of each design stay the same */
+		explored = *paretoArchive;
+		REFINE_GLOBAL_WIRE_FORLOOP {
+			LOAD_REFINED_GLOBAL_WIRE;
+			for (int i = 0; i < explored.Size(); i++) {
+				const DesignPoint &point = explored.Point(i);
+				if (point.globalWireType == globalWireType && point.globalWireRepeaterType == globalWireRepeaterType
+						&& point.isGlobalWireLowSwing == isGlobalWireLowSwing)
+					continue;	/* Already on the frontier */
+				LOAD_LOCAL_WIRE_FROM_POINT(point);
+				CALCULATE_FROM_POINT(trialBank, point, MemoryType::data);
+				if (!trialBank->invalid)
+					paretoArchive->Insert(*trialBank, *localWire, *globalWire);
+				BankPool::ThreadPool().Release(trialBank);
+			}
+		}
+
+		/* print the frontier, each design is calculated again from its organization and wires */
+		paretoArchive->Sort();
+		for (int i = 0; i < paretoArchive->Size(); i++) {
+			const DesignPoint &point = paretoArchive->Point(i);
+			LOAD_LOCAL_WIRE_FROM_POINT(point);
+			LOAD_GLOBAL_WIRE_FROM_POINT(point);
+			CALCULATE_FROM_POINT(trialBank, point, MemoryType::data);
+			*(tempResult.bank) = *trialBank;
+			*(tempResult.localWire) = *localWire;
+			*(tempResult.globalWire) = *globalWire;
+			OUTPUT_TO_FILE;
+			BankPool::ThreadPool().Release(trialBank);
+		}
+		log << "Pareto frontier = " << paretoArchive->Size() << " designs" << endl;
+	} else if (numSolution > 0) {
 		Bank * trialBank;
-		Result tempResult;
 		/* refine local wire type */
 		REFINE_LOCAL_WIRE_FORLOOP {
-			localWire->Initialize(inputParameter->processNode, (WireType)localWireType,
-					(WireRepeaterType)localWireRepeaterType, inputParameter->temperature,
-					(bool)isLocalWireLowSwing);
+			LOAD_REFINED_LOCAL_WIRE;
 			for (int i = 0; i < (int)full_exploration; i++) {
 				LOAD_GLOBAL_WIRE(bestDataResults[i]);
 				TRY_AND_UPDATE(bestDataResults[i], MemoryType::data);
@@ -498,23 +789,27 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 				OUTPUT_TO_FILE;
 			}
 		}
-		/* refine global wire type */
+		/* refine global wire type, the organization and the local wire of each result stay the same */
+		Bank *routedBanks[(int)full_exploration] = {NULL};
 		REFINE_GLOBAL_WIRE_FORLOOP {
-			globalWire->Initialize(inputParameter->processNode, (WireType)globalWireType,
-					(WireRepeaterType)globalWireRepeaterType, inputParameter->temperature,
-					(bool)isGlobalWireLowSwing);
+			LOAD_REFINED_GLOBAL_WIRE;
 			for (int i = 0; i < (int)full_exploration; i++) {
 				LOAD_LOCAL_WIRE(bestDataResults[i]);
-				TRY_AND_UPDATE(bestDataResults[i], MemoryType::data);
+				REROUTE_AND_UPDATE(routedBanks[i], bestDataResults[i], MemoryType::data);
 			}
 			if (inputParameter->optimizationTarget == full_exploration && !inputParameter->isPruningEnabled) {
 				OUTPUT_TO_FILE;
 			}
 		}
+		for (int i = 0; i < (int)full_exploration; i++)
+			if (routedBanks[i])
+				BankPool::ThreadPool().Release(routedBanks[i]);
 	}
+	wireRefinement.Stop();
 
 	if (inputParameter->optimizationTarget == full_exploration && inputParameter->isPruningEnabled) {
 		/* pruning is enabled */
+		PROFILE(profile_pruning);
 		Result **** pruningResults;
 		/* pruningResults[x][y][z] points to the result which is optimized for x, with constraint on y with z overhead */
 		pruningResults = new Result***[(int)full_exploration];	/* full_exploration is always set as the last element in the enum, so if full_exploration is 8, what we want here is a 0-7 array, which is correct */
@@ -561,16 +856,63 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 						break;
 					default:
 						/* nothing should happen here */
-						cout << "Warning: should not happen" << endl;
+						log << "Warning: should not happen" << endl;
 					}
 				}
 
-		for (int i = 0; i < (int)full_exploration; i++) {
-			bestDataResults[i].printAsCacheToCsvFile(bestTagResults[i], inputParameter->cacheAccessMode, outputFile);
+		/* Find the constrained optima among the stored designs, which have the basic wires */
+		Bank * trialBank;
+		for (int i = 0; i < (int)full_exploration; i++)
+			for (int j = 0; j < (int)full_exploration; j++)
+				for (int k = 0; k < 3; k++) {
+					int best = designStore.FindBest(*pruningResults[i][j][k]);
+					if (best < 0)
+						continue;
+					const DesignPoint &point = designStore.Point(best);
+					LOAD_LOCAL_WIRE_FROM_POINT(point);
+					LOAD_GLOBAL_WIRE_FROM_POINT(point);
+					CALCULATE_FROM_POINT(trialBank, point, MemoryType::data);
+					UPDATE_FROM_BANK(trialBank, (*pruningResults[i][j][k]));
+					BankPool::ThreadPool().Release(trialBank);
+				}
+
+		/* Refine the wires of the constrained optima the same way as those of the best results */
+		REFINE_LOCAL_WIRE_FORLOOP {
+			LOAD_REFINED_LOCAL_WIRE;
+			for (int i = 0; i < (int)full_exploration; i++)
+				for (int j = 0; j < (int)full_exploration; j++)
+					for (int k = 0; k < 3; k++) {
+						if (pruningResults[i][j][k]->bank->area >= invalid_value)
+							continue;	/* No design meets the constraint */
+						LOAD_GLOBAL_WIRE((*pruningResults[i][j][k]));
+						TRY_AND_UPDATE((*pruningResults[i][j][k]), MemoryType::data);
+					}
 		}
-		cout << "Pruning done" << endl;
-		/* Run pruning here */
-		/* TO-DO */
+		REFINE_GLOBAL_WIRE_FORLOOP {
+			LOAD_REFINED_GLOBAL_WIRE;
+			for (int i = 0; i < (int)full_exploration; i++)
+				for (int j = 0; j < (int)full_exploration; j++)
+					for (int k = 0; k < 3; k++) {
+						if (pruningResults[i][j][k]->bank->area >= invalid_value)
+							continue;
+						LOAD_LOCAL_WIRE((*pruningResults[i][j][k]));
+						TRY_AND_UPDATE((*pruningResults[i][j][k]), MemoryType::data);
+					}
+		}
+
+		/* The best results first, then the constrained optima in the x, y, z order */
+		for (int i = 0; i < (int)full_exploration; i++)
+			OUTPUT_RESULT(bestDataResults[i], bestTagResults[i]);
+		int numPrunedResult = 0;
+		for (int i = 0; i < (int)full_exploration; i++)
+			for (int j = 0; j < (int)full_exploration; j++)
+				for (int k = 0; k < 3; k++) {
+					if (pruningResults[i][j][k]->bank->area >= invalid_value)
+						continue;
+					OUTPUT_RESULT(*pruningResults[i][j][k], bestTagResults[i]);
+					numPrunedResult++;
+				}
+		log << "Pruning done, " << numPrunedResult << " constrained optima from " << designStore.Size() << " designs" << endl;
 
 		/* delete */
 		for (int i = 0; i < (int)full_exploration; i++) {
@@ -584,7 +926,9 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 	}
 
 	/* If design constraint is applied */
-	if (inputParameter->optimizationTarget != full_exploration && inputParameter->isConstraintApplied) {
+	if (inputParameter->optimizationTarget != full_exploration && inputParameter->optimizationTarget != pareto_exploration
+			&& inputParameter->isConstraintApplied) {
+		PROFILE(profile_constraint_pass);
 		double allowedDataReadLatency = bestDataResults[read_latency_optimized].bank->readLatency * (inputParameter->readLatencyConstraint + 1);
 		double allowedDataWriteLatency = bestDataResults[write_latency_optimized].bank->writeLatency * (inputParameter->writeLatencyConstraint + 1);
 		double allowedDataReadDynamicEnergy = bestDataResults[read_energy_optimized].bank->readDynamicEnergy * (inputParameter->readDynamicEnergyConstraint + 1);
@@ -599,29 +943,46 @@ int nvsim(ofstream& outputFile, string inputFileName, long long& numSolution, Re
 			APPLY_LIMIT(bestDataResults[i]);
 		}
 
-		numSolution = 0;
-		INITIAL_BASIC_WIRE;
-		BIGFOR {
-			if (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) == 0) {
-				/* To aggressive partitioning */
+		/* The constrained optima are among the designs of the first pass, which have the basic wires */
+		numSolution = designStore.Count(bestDataResults[0]);
+		Bank * trialBank;
+		for (int i = 0; i < (int)full_exploration; i++) {
+			int best = designStore.FindBest(bestDataResults[i]);
+			if (best < 0)
 				continue;
-			}
-			CALCULATE(dataBank, MemoryType::data);
-            numDesigns++;
-			if (!dataBank->invalid && dataBank->readLatency <= allowedDataReadLatency && dataBank->writeLatency <= allowedDataWriteLatency
-					&& dataBank->readDynamicEnergy <= allowedDataReadDynamicEnergy && dataBank->writeDynamicEnergy <= allowedDataWriteDynamicEnergy
-					&& dataBank->leakage <= allowedDataLeakage && dataBank->area <= allowedDataArea
-					&& dataBank->readLatency * dataBank->readDynamicEnergy <= allowedDataReadEdp && dataBank->writeLatency * dataBank->writeDynamicEnergy <= allowedDataWriteEdp) {
-				Result tempResult;
-				VERIFY_DATA_CAPACITY;
-				numSolution++;
-				UPDATE_BEST_DATA;
-			}
-			delete dataBank;
+			const DesignPoint &point = designStore.Point(best);
+			LOAD_LOCAL_WIRE_FROM_POINT(point);
+			LOAD_GLOBAL_WIRE_FROM_POINT(point);
+			CALCULATE_FROM_POINT(trialBank, point, MemoryType::data);
+			UPDATE_FROM_BANK(trialBank, bestDataResults[i]);
+			BankPool::ThreadPool().Release(trialBank);
 		}
 	}
 
-    cout << "numSolutions = " << numSolution << " / numDesigns = " << numDesigns << endl;
+	if (tagThread.joinable()) {
+		tagThread.join();
+		if (numTagSolution == 0) {
+			log << "No valid solutions for tags." << endl;
+			log << endl << "Finished!" << endl;
+			if (localWire) delete localWire;
+			if (globalWire) delete globalWire;
+			return 1;
+		}
+	}
+
+    log << "numSolutions = " << numSolution << " / numDesigns = " << numDesigns << endl;
+	designFilter.PrintStatistics(log);
+	if (searchBound.enabled)
+		log << "numPruned = " << numPruned << " (branch and bound)" << endl;
+	else if (inputParameter->branchAndBound && inputParameter->optimizationTarget < full_exploration) {
+		/* Say why the search was exhaustive although branch and bound is on */
+		if (inputParameter->printAllOptimals)
+			log << "Branch and bound is disabled with -PrintAllOptimals, the search is exhaustive" << endl;
+		else if (inputParameter->isConstraintApplied)
+			log << "Branch and bound is disabled with design constraints, the search is exhaustive" << endl;
+		else if (inputParameter->routingMode != h_tree)
+			log << "Branch and bound is disabled for non-H-tree routing, the search is exhaustive" << endl;
+	}
 
 	if (localWire) delete localWire;
 	if (globalWire) delete globalWire;
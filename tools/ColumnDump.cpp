@@ -0,0 +1,186 @@
+//Copyright (c) 2015-2016, UT-Battelle, LLC. See LICENSE file in the top-level directory
+//No part of DESTINY Project, including this file, may be copied,
+//modified, propagated, or distributed except according to the terms
+//contained in the LICENSE file.
+
+/* Reader of the binary output file of -OutputFormat: binary.
+ * It prints the selected columns of the designs that pass every filter as csv, or only their number.
+ * The filters are evaluated one column at a time on the mapped chunks, so only the columns that are
+ * filtered or printed are read.
+ *
+ * Usage: column_dump <binary file> [-s] [-n] [-c column,column,...] [-w <column><op><value>]...
+ *   -s  print the columns of the file and exit
+ *   -n  print the number of matching designs only
+ *   -c  columns to print, all of them by default
+ *   -w  filter, op is one of < <= > >= == !=, for example -w readLatency<2e-9 */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "ColumnFile.h"
+
+using namespace std;
+
+enum FilterOperator {
+	filter_less,
+	filter_less_equal,
+	filter_greater,
+	filter_greater_equal,
+	filter_equal,
+	filter_not_equal
+};
+
+struct Filter {
+	int col;
+	FilterOperator op;
+	double value;
+};
+
+bool ParseFilter(const ColumnFileReader &reader, const string &text, Filter &filter) {
+	static const char *operators[] = {"<=", ">=", "==", "!=", "<", ">"};
+	static const FilterOperator codes[] = {filter_less_equal, filter_greater_equal, filter_equal, filter_not_equal,
+			filter_less, filter_greater};
+	for (int i = 0; i < 6; i++) {
+		size_t position = text.find(operators[i]);
+		if (position == string::npos || position == 0)
+			continue;
+		filter.col = reader.FindColumn(text.substr(0, position));
+		if (filter.col < 0) {
+			cout << "[ERROR] Unknown column in filter: " << text << endl;
+			return false;
+		}
+		filter.op = codes[i];
+		filter.value = atof(text.c_str() + position + strlen(operators[i]));
+		return true;
+	}
+	cout << "[ERROR] Filter without operator: " << text << endl;
+	return false;
+}
+
+/* Clear the rows of the chunk that fail the filter */
+template <class T>
+void ApplyFilter(const T *values, uint64_t numRow, const Filter &filter, vector<char> &pass) {
+	T value = (T)filter.value;
+	for (uint64_t row = 0; row < numRow; row++) {
+		switch (filter.op) {
+		case filter_less:
+			pass[row] &= (values[row] < value);
+			break;
+		case filter_less_equal:
+			pass[row] &= (values[row] <= value);
+			break;
+		case filter_greater:
+			pass[row] &= (values[row] > value);
+			break;
+		case filter_greater_equal:
+			pass[row] &= (values[row] >= value);
+			break;
+		case filter_equal:
+			pass[row] &= (values[row] == value);
+			break;
+		default:
+			pass[row] &= (values[row] != value);
+		}
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		cout << "Usage: " << argv[0] << " <binary file> [-s] [-n] [-c column,column,...] [-w <column><op><value>]..." << endl;
+		exit(-1);
+	}
+
+	ColumnFileReader reader;
+	if (!reader.Open(argv[1])) {
+		cout << "[ERROR] " << argv[1] << " is not a binary output file" << endl;
+		exit(-1);
+	}
+
+	bool printSchema = false, countOnly = false;
+	vector<int> selected;
+	vector<Filter> filters;
+	for (int argIdx = 2; argIdx < argc; argIdx++) {
+		string arg = argv[argIdx];
+		if (arg == "-s") {
+			printSchema = true;
+		} else if (arg == "-n") {
+			countOnly = true;
+		} else if (arg == "-c" && argIdx + 1 < argc) {
+			string list = argv[++argIdx];
+			size_t start = 0;
+			while (start <= list.size()) {
+				size_t end = list.find(',', start);
+				if (end == string::npos)
+					end = list.size();
+				int col = reader.FindColumn(list.substr(start, end - start));
+				if (col < 0) {
+					cout << "[ERROR] Unknown column: " << list.substr(start, end - start) << endl;
+					exit(-1);
+				}
+				selected.push_back(col);
+				start = end + 1;
+			}
+		} else if (arg == "-w" && argIdx + 1 < argc) {
+			Filter filter;
+			if (!ParseFilter(reader, argv[++argIdx], filter))
+				exit(-1);
+			filters.push_back(filter);
+		} else {
+			cout << "[ERROR] Unknown option: " << arg << endl;
+			exit(-1);
+		}
+	}
+
+	if (printSchema) {
+		cout << (reader.isCache ? "cache" : "memory") << " designs: " << reader.numRow << " in "
+				<< reader.chunkRows.size() << " chunks" << endl;
+		for (int col = 0; col < (int)reader.columns.size(); col++)
+			cout << reader.columns[col].name << "," << (reader.columns[col].type == column_int32 ? "int32" : "float64") << endl;
+		return 0;
+	}
+
+	if (selected.empty())
+		for (int col = 0; col < (int)reader.columns.size(); col++)
+			selected.push_back(col);
+	if (!countOnly) {
+		for (int i = 0; i < (int)selected.size(); i++)
+			printf("%s%s", i ? "," : "", reader.columns[selected[i]].name);
+		printf("\n");
+	}
+
+	uint64_t numMatch = 0;
+	vector<char> pass;
+	for (int chunk = 0; chunk < (int)reader.chunkRows.size(); chunk++) {
+		uint64_t numRow = reader.chunkRows[chunk];
+		pass.assign(numRow, 1);
+		for (int i = 0; i < (int)filters.size(); i++) {
+			const void *values = reader.Column(chunk, filters[i].col);
+			if (reader.columns[filters[i].col].type == column_int32)
+				ApplyFilter((const int32_t *)values, numRow, filters[i], pass);
+			else
+				ApplyFilter((const double *)values, numRow, filters[i], pass);
+		}
+		for (uint64_t row = 0; row < numRow; row++) {
+			if (!pass[row])
+				continue;
+			numMatch++;
+			if (countOnly)
+				continue;
+			for (int i = 0; i < (int)selected.size(); i++) {
+				if (reader.columns[selected[i]].type == column_int32)
+					printf("%s%d", i ? "," : "", ((const int32_t *)reader.Column(chunk, selected[i]))[row]);
+				else
+					printf("%s%.10g", i ? "," : "", ((const double *)reader.Column(chunk, selected[i]))[row]);
+			}
+			printf("\n");
+		}
+	}
+	if (countOnly)
+		printf("%llu\n", (unsigned long long)numMatch);
+
+	return 0;
+}
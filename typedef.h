@@ -105,7 +105,8 @@ enum OptimizationTarget
 	write_edp_optimized = 5,
 	leakage_optimized = 6,
 	area_optimized = 7,
-	full_exploration = 8
+	full_exploration = 8,
+	pareto_exploration = 9	/* Not a best result, kept after full_exploration so that it is not counted as a target */
 };
 
 enum CacheAccessMode
@@ -117,6 +118,19 @@ enum CacheAccessMode
 	fast_access_mode		/* data and tag access happen in parallel */
 };
 
+enum OutputFormat
+{
+	csv_format,		/* One text row per design */
+	binary_format	/* Columns of DesignRecord or CacheDesignRecord, see ColumnFile.h */
+};
+
+enum ProfileFormat
+{
+	no_profile,
+	table_profile,	/* Printed at the end of the output */
+	json_profile	/* Written to <cfg>.profile.json */
+};
+
 enum TSV_type 
 {
     Fine = 0,        // ITRS high density